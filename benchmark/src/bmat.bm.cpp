@@ -0,0 +1,77 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains some benchmarks for libsemigroups/src/bmat.h, comparing
+// BMat16 and BMat64 with BooleanMat.
+
+#include <benchmark/benchmark.h>
+#include <libsemigroups/bmat.h>
+#include <libsemigroups/semigroups.h>
+
+using namespace libsemigroups;
+
+// The generators of the monoid of regular boolean matrices of dimension 4.
+static std::vector<std::vector<std::vector<bool>>> const GENS
+    = {{{0, 1, 0, 0}, {1, 0, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}},
+       {{0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}, {1, 0, 0, 0}},
+       {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 1}},
+       {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 0}}};
+
+template <size_t N> static std::vector<BMat<N>> bmat_gens() {
+  std::vector<BMat<N>> gens;
+  for (auto const& x : GENS) {
+    std::vector<std::vector<size_t>> rows;
+    for (auto const& row : x) {
+      rows.emplace_back(row.begin(), row.end());
+    }
+    gens.emplace_back(rows);
+  }
+  return gens;
+}
+
+template <size_t N>
+static void BM_BMat_regular_boolean_mat_monoid_4(benchmark::State& state) {
+  std::vector<BMat<N>> gens = bmat_gens<N>();
+  while (state.KeepRunning()) {
+    Semigroup<BMat<N>> S(gens);
+    S.size();
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_BMat_regular_boolean_mat_monoid_4, 16)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BMat_regular_boolean_mat_monoid_4, 64)
+    ->Unit(benchmark::kMillisecond);
+
+static void
+BM_BooleanMat_regular_boolean_mat_monoid_4(benchmark::State& state) {
+  std::vector<Element*> gens;
+  for (auto const& x : GENS) {
+    gens.push_back(new BooleanMat(x));
+  }
+  while (state.KeepRunning()) {
+    Semigroup<> S(gens);
+    S.size();
+  }
+  really_delete_cont(gens);
+}
+
+BENCHMARK(BM_BooleanMat_regular_boolean_mat_monoid_4)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
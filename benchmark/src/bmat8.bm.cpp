@@ -19,6 +19,7 @@
 // This file contains some benchmarks for libsemigroups/src/bmat8.*.
 
 #include <chrono>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 #include <libsemigroups/bmat8.h>
@@ -71,4 +72,94 @@ static void BM_BMat8_multiply(benchmark::State& state) {
 
 BENCHMARK(BM_BMat8_multiply)->UseManualTime()->MinTime(1);
 
+static void BM_BMat8_row_space_basis(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    BMat8 bm    = BMat8::random();
+    auto  start = std::chrono::high_resolution_clock::now();
+    benchmark::DoNotOptimize(bm.row_space_basis());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+}
+
+BENCHMARK(BM_BMat8_row_space_basis)->UseManualTime()->MinTime(1);
+
+static void BM_BMat8_row_space_size(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    BMat8 bm    = BMat8::random();
+    auto  start = std::chrono::high_resolution_clock::now();
+    benchmark::DoNotOptimize(bm.row_space_size());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+}
+
+BENCHMARK(BM_BMat8_row_space_size)->UseManualTime()->MinTime(1);
+
+static void BM_BMat8_row_space_equal(benchmark::State& state) {
+  while (state.KeepRunning()) {
+    BMat8 bm1   = BMat8::random();
+    BMat8 bm2   = bm1.row_space_basis();
+    auto  start = std::chrono::high_resolution_clock::now();
+    benchmark::DoNotOptimize(bm1.row_space_equal(bm2));
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+}
+
+BENCHMARK(BM_BMat8_row_space_equal)->UseManualTime()->MinTime(1);
+
+static void BM_BMat8_multiply_loop(benchmark::State& state) {
+  std::vector<BMat8> in(state.range(0));
+  std::vector<BMat8> out(in.size());
+  for (BMat8& y : in) {
+    y = BMat8::random();
+  }
+  BMat8 x = BMat8::random();
+  while (state.KeepRunning()) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < in.size(); ++i) {
+      out[i] = x * in[i];
+    }
+    benchmark::DoNotOptimize(out.data());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+}
+
+BENCHMARK(BM_BMat8_multiply_loop)->Arg(1 << 16)->UseManualTime()->MinTime(1);
+
+static void BM_BMat8_multiply_left(benchmark::State& state) {
+  std::vector<BMat8> in(state.range(0));
+  std::vector<BMat8> out(in.size());
+  for (BMat8& y : in) {
+    y = BMat8::random();
+  }
+  BMat8 x = BMat8::random();
+  while (state.KeepRunning()) {
+    auto start = std::chrono::high_resolution_clock::now();
+    BMat8::multiply_left(x, in.data(), out.data(), in.size());
+    benchmark::DoNotOptimize(out.data());
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+}
+
+BENCHMARK(BM_BMat8_multiply_left)->Arg(1 << 16)->UseManualTime()->MinTime(1);
+
 BENCHMARK_MAIN();
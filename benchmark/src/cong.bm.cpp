@@ -70,6 +70,48 @@ BENCHMARK(BM_Congruence_full_PBR_monoid)
     ->Repetitions(2)
     ->UseManualTime();
 
+static void BM_Congruence_full_BitPBR_monoid(benchmark::State& state) {
+  using adj_t = std::vector<std::vector<u_int32_t>>;
+  while (state.KeepRunning()) {
+    std::vector<Element*> gens
+        = {new BitPBR(adj_t({{2}, {3}, {0}, {1}})),
+           new BitPBR(adj_t({{}, {2}, {1}, {0, 3}})),
+           new BitPBR(adj_t({{0, 3}, {2}, {1}, {}})),
+           new BitPBR(adj_t({{1, 2}, {3}, {0}, {1}})),
+           new BitPBR(adj_t({{2}, {3}, {0}, {1, 3}})),
+           new BitPBR(adj_t({{3}, {1}, {0}, {1}})),
+           new BitPBR(adj_t({{3}, {2}, {0}, {0, 1}})),
+           new BitPBR(adj_t({{3}, {2}, {0}, {1}})),
+           new BitPBR(adj_t({{3}, {2}, {0}, {3}})),
+           new BitPBR(adj_t({{3}, {2}, {1}, {0}})),
+           new BitPBR(adj_t({{3}, {2, 3}, {0}, {1}}))};
+
+    Semigroup S = Semigroup(gens);
+    S.set_report(false);
+    really_delete_cont(gens);
+
+    std::vector<relation_t> extra(
+        {relation_t({7, 10, 9, 3, 6, 9, 4, 7, 9, 10},
+                    {9, 3, 6, 6, 10, 9, 4, 7}),
+         relation_t({8, 7, 5, 8, 9, 8}, {6, 3, 8, 6, 1, 2, 4})});
+    Congruence cong("twosided", &S, extra);
+    cong.set_report(false);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    cong.nr_classes();
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed_seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(end
+                                                                    - start);
+    state.SetIterationTime(elapsed_seconds.count());
+  }
+}
+
+BENCHMARK(BM_Congruence_full_BitPBR_monoid)
+    ->Unit(benchmark::kMillisecond)
+    ->Repetitions(2)
+    ->UseManualTime();
+
 static void BM_Congruence_full_PBR_monoid_max_2(benchmark::State& state) {
   while (state.KeepRunning()) {
     std::vector<Element*> gens = {
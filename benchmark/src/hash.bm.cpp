@@ -0,0 +1,153 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains some benchmarks for the hash functions of the elements in
+// libsemigroups/src/elements.h. Every benchmark enumerates (at most limit
+// elements of) a semigroup, and its label records the number of distinct hash
+// values of its elements, and the average number of elements compared when
+// looking up an element in a hash table with the same number of buckets as
+// the one used by Semigroup. Compare with libsemigroups configured with
+// --disable-mixhash.
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <libsemigroups/semigroups.h>
+
+#include "examples.h"
+
+using namespace libsemigroups;
+
+static std::string hash_label(std::vector<Element*> const& gens,
+                              size_t                       limit) {
+  Semigroup<> S(gens);
+  S.enumerate(limit);
+  size_t const n = S.current_size();
+
+  std::unordered_set<size_t> tmp;
+  tmp.reserve(n);
+  size_t const               nr_buckets = tmp.bucket_count();
+  std::vector<size_t>        buckets(nr_buckets, 0);
+  std::unordered_set<size_t> hashes;
+  for (size_t i = 0; i < n; ++i) {
+    size_t const h = S.at(i)->hash_value();
+    hashes.insert(h);
+    buckets[h % nr_buckets]++;
+  }
+  double probes = 0;
+  for (size_t b : buckets) {
+    probes += b * (b + 1) / 2.0;
+  }
+  return std::to_string(hashes.size()) + "/" + std::to_string(n)
+         + " distinct, " + std::to_string(probes / n) + " probes";
+}
+
+static void bm_hash(benchmark::State&      state,
+                    std::vector<Element*>* gens,
+                    size_t                 limit) {
+  while (state.KeepRunning()) {
+    Semigroup<> S(*gens);
+    S.enumerate(limit);
+  }
+  state.SetLabel(hash_label(*gens, limit));
+  really_delete_cont(gens);
+}
+
+static std::vector<Element*>* full_transformation_monoid(size_t n) {
+  std::vector<u_int8_t> cycle(n), swap(n), collapse(n);
+  for (size_t i = 0; i < n; ++i) {
+    cycle[i]    = (i + 1) % n;
+    swap[i]     = i;
+    collapse[i] = i;
+  }
+  swap[0]     = 1;
+  swap[1]     = 0;
+  collapse[0] = 1;
+  return new std::vector<Element*>({new Transformation<u_int8_t>(cycle),
+                                    new Transformation<u_int8_t>(swap),
+                                    new Transformation<u_int8_t>(collapse)});
+}
+
+static std::vector<Element*>* symmetric_inverse_monoid(size_t n) {
+  std::vector<u_int32_t> cycle(n), swap(n), restrict(n);
+  for (size_t i = 0; i < n; ++i) {
+    cycle[i]    = (i + 1) % n;
+    swap[i]     = i;
+    restrict[i] = i;
+  }
+  swap[0]     = 1;
+  swap[1]     = 0;
+  restrict[0] = PartialPerm<u_int32_t>::UNDEFINED;
+  return new std::vector<Element*>({new PartialPerm<u_int32_t>(cycle),
+                                    new PartialPerm<u_int32_t>(swap),
+                                    new PartialPerm<u_int32_t>(restrict)});
+}
+
+static void BM_hash_full_transformation_monoid_7(benchmark::State& state) {
+  bm_hash(state, full_transformation_monoid(7), -1);
+}
+
+static void BM_hash_full_transformation_monoid_32(benchmark::State& state) {
+  bm_hash(state, full_transformation_monoid(32), 500000);
+}
+
+static void BM_hash_full_transformation_monoid_64(benchmark::State& state) {
+  bm_hash(state, full_transformation_monoid(64), 500000);
+}
+
+static void BM_hash_symmetric_inverse_monoid_7(benchmark::State& state) {
+  bm_hash(state, symmetric_inverse_monoid(7), -1);
+}
+
+static void BM_hash_symmetric_inverse_monoid_32(benchmark::State& state) {
+  bm_hash(state, symmetric_inverse_monoid(32), 500000);
+}
+
+static void BM_hash_partition_monoid_5(benchmark::State& state) {
+  bm_hash(state,
+          new std::vector<Element*>(
+              {new Bipartition({0, 1, 2, 3, 4, 4, 0, 1, 2, 3}),
+               new Bipartition({0, 1, 2, 3, 4, 1, 0, 2, 3, 4}),
+               new Bipartition({0, 1, 2, 3, 4, 5, 1, 2, 3, 4}),
+               new Bipartition({0, 0, 1, 2, 3, 0, 0, 1, 2, 3})}),
+          -1);
+}
+
+static void BM_hash_gossip_4(benchmark::State& state) {
+  bm_hash(state, gossip(4), -1);
+}
+
+static void BM_hash_upper_triangular_boolean_mat_5(benchmark::State& state) {
+  bm_hash(state, upper_triangular_boolean_mat(5), -1);
+}
+
+BENCHMARK(BM_hash_full_transformation_monoid_7)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hash_full_transformation_monoid_32)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hash_full_transformation_monoid_64)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hash_symmetric_inverse_monoid_7)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hash_symmetric_inverse_monoid_32)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hash_partition_monoid_5)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hash_gossip_4)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_hash_upper_triangular_boolean_mat_5)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,438 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains a declaration of fast boolean matrices of dimension
+// 16 x 16, 32 x 32, and 64 x 64.
+
+#ifndef LIBSEMIGROUPS_SRC_BMAT_H_
+#define LIBSEMIGROUPS_SRC_BMAT_H_
+
+#include <string.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "hash.h"
+#include "libsemigroups-debug.h"
+
+namespace libsemigroups {
+
+  //! Class for fast boolean matrices of dimension up to \p N x \p N.
+  //!
+  //! The template parameter \p N must be one of 16, 32, or 64; the type
+  //! aliases BMat16, BMat32, and BMat64 are provided for these values.
+  //! Each row of a BMat is stored in a single unsigned integer of \p N bits,
+  //! the entry in column \c j of a row being its \f$(N - j - 1)\f$-th bit,
+  //! so that the methods of this class operate on whole rows at a time.
+  //! As for BMat8, all BMat are represented internally as an \p N x \p N
+  //! matrix; any entries not defined by the user are taken to be 0, which
+  //! does not affect the results of any calculations.
+  //!
+  //! BMat is a trivial class, and can be used with Semigroup in the same way
+  //! as BMat8.
+  template <size_t N> class BMat {
+    static_assert(N == 16 || N == 32 || N == 64,
+                  "the dimension of a BMat must be 16, 32, or 64");
+
+   public:
+    //! The type of the rows of a BMat.
+    //!
+    //! This is an unsigned integer type with exactly \p N bits.
+    typedef typename std::conditional<
+        N == 16,
+        uint16_t,
+        typename std::conditional<N == 32, uint32_t, uint64_t>::type>::type
+        row_type;
+
+    //! A default constructor.
+    //!
+    //! This constructor gives no guarantees on what the matrix will contain.
+    BMat() = default;
+
+    //! A constructor.
+    //!
+    //! This constructor initializes a matrix where the rows of the matrix
+    //! are the vectors in \p mat. This method asserts that \p mat has at most
+    //! \p N rows, each of length at most \p N, and that every entry is 0 or
+    //! 1.
+    explicit BMat(std::vector<std::vector<size_t>> const& mat) {
+      LIBSEMIGROUPS_ASSERT(mat.size() <= N);
+      memset(_rows, 0, sizeof(_rows));
+      for (size_t i = 0; i < mat.size(); ++i) {
+        LIBSEMIGROUPS_ASSERT(mat[i].size() <= N);
+        for (size_t j = 0; j < mat[i].size(); ++j) {
+          LIBSEMIGROUPS_ASSERT(mat[i][j] == 0 || mat[i][j] == 1);
+          if (mat[i][j]) {
+            _rows[i] |= bit(j);
+          }
+        }
+      }
+    }
+
+    //! A constructor.
+    //!
+    //! This is the copy constructor.
+    BMat(BMat const&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the move constructor.
+    BMat(BMat&&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the copy assignement constructor.
+    BMat& operator=(BMat const&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the move assignment  constructor.
+    BMat& operator=(BMat&&) = default;
+
+    //! A default destructor.
+    ~BMat() = default;
+
+    //! Returns \c true if \c this equals \p that.
+    //!
+    //! This method checks the mathematical equality of two BMat objects.
+    bool operator==(BMat const& that) const {
+      return memcmp(_rows, that._rows, sizeof(_rows)) == 0;
+    }
+
+    //! Returns \c true if \c this does not equal \p that
+    //!
+    //! This method checks the mathematical inequality of two BMat objects.
+    bool operator!=(BMat const& that) const {
+      return !(*this == that);
+    }
+
+    //! Returns \c true if \c this is less than \p that.
+    //!
+    //! This method checks whether a BMat objects is less than another.
+    //! We order the matrices lexicographically by their rows, each row being
+    //! compared as an unsigned integer, which is the same order as that of
+    //! BMat8.
+    bool operator<(BMat const& that) const {
+      return std::lexicographical_compare(
+          _rows, _rows + N, that._rows, that._rows + N);
+    }
+
+    //! Returns \c true if \c this is greater than \p that.
+    //!
+    //! This method checks whether a BMat objects is greater than another.
+    //! See BMat::operator< for details of the order.
+    bool operator>(BMat const& that) const {
+      return that < *this;
+    }
+
+    //! Returns the entry in the (\p i, \p j)th position.
+    //!
+    //! This method asserts that \p i and \p j are less than \p N.
+    bool operator()(size_t i, size_t j) const {
+      LIBSEMIGROUPS_ASSERT(i < N && j < N);
+      return _rows[i] & bit(j);
+    }
+
+    //! Sets the (\p i, \p j)th position to \p val.
+    //!
+    //! This method asserts that \p i and \p j are less than \p N.
+    inline void set(size_t i, size_t j, bool val) {
+      LIBSEMIGROUPS_ASSERT(i < N && j < N);
+      _rows[i] ^= (-static_cast<row_type>(val) ^ _rows[i]) & bit(j);
+    }
+
+    //! Returns the \p i-th row of \c this.
+    //!
+    //! The entry in column \c j of the row is its \f$(N - j - 1)\f$-th bit.
+    //! This method asserts that \p i is less than \p N.
+    inline row_type row(size_t i) const {
+      LIBSEMIGROUPS_ASSERT(i < N);
+      return _rows[i];
+    }
+
+    //! Returns the transpose of \c this
+    //!
+    //! Returns the standard matrix transpose of a BMat. This method
+    //! recursively swaps the off-diagonal blocks of \c this using
+    //! \f$\log_2 N\f$ passes over the rows, as described in Hacker's Delight,
+    //! Section 7-3.
+    BMat transpose() const {
+      BMat     t(*this);
+      row_type m = LOW_HALF;
+      for (size_t j = N / 2; j != 0;
+           j >>= 1, m ^= static_cast<row_type>(m << j)) {
+        for (size_t k = 0; k < N; k = ((k | j) + 1) & ~j) {
+          row_type const x = (t._rows[k] ^ (t._rows[k | j] >> j)) & m;
+          t._rows[k] ^= x;
+          t._rows[k | j] ^= static_cast<row_type>(x << j);
+        }
+      }
+      return t;
+    }
+
+    //! Returns the matrix product of \c this and \p that
+    //!
+    //! This method returns the standard matrix product (over the boolean
+    //! semiring) of two BMat objects. Every row of the product is the union
+    //! of those rows of \p that indexed by the entries of the corresponding
+    //! row of \c this. The entries of each row of \c this are only read up
+    //! to the last non-zero one, so that the cost of a product depends on
+    //! the number of rows and columns actually used rather than on \p N.
+    BMat operator*(BMat const& that) const {
+      BMat xy;
+      for (size_t i = 0; i < N; ++i) {
+        row_type x   = _rows[i];
+        row_type row = 0;
+        for (size_t j = 0; x != 0; ++j) {
+          // mask is all 1s if the entry in column j is 1, and 0 if not.
+          row_type const mask = -static_cast<row_type>(x >> (N - 1));
+          row |= that._rows[j] & mask;
+          x = static_cast<row_type>(x << 1);
+        }
+        xy._rows[i] = row;
+      }
+      return xy;
+    }
+
+    //! Returns the identity BMat
+    //!
+    //! This method returns the \p N x \p N BMat with 1s on the main diagonal.
+    BMat one() const {
+      BMat id;
+      for (size_t i = 0; i < N; ++i) {
+        id._rows[i] = bit(i);
+      }
+      return id;
+    }
+
+    //! Returns a BMat whose rows form a basis for the row space of \c this.
+    //!
+    //! The row space of a boolean matrix is the set of all unions of its
+    //! rows, and its basis is the unique set of non-zero rows that are not
+    //! unions of other rows. The rows of the returned matrix are the basis
+    //! vectors, in decreasing order, followed by zero rows.
+    BMat row_space_basis() const {
+      row_type rows[N];
+      std::copy(_rows, _rows + N, rows);
+      std::sort(rows, rows + N, std::greater<row_type>());
+      size_t const nr_rows = std::unique(rows, rows + N) - rows;
+
+      BMat   basis;
+      size_t next = 0;
+      memset(basis._rows, 0, sizeof(basis._rows));
+      for (size_t i = 0; i < nr_rows && rows[i] != 0; ++i) {
+        // Rows are distinct, so every other row contained in rows[i] is
+        // properly contained in it.
+        row_type cup = 0;
+        for (size_t j = i + 1; j < nr_rows; ++j) {
+          if ((rows[j] | rows[i]) == rows[i]) {
+            cup |= rows[j];
+          }
+        }
+        if (cup != rows[i]) {
+          basis._rows[next++] = rows[i];
+        }
+      }
+      return basis;
+    }
+
+    //! Returns a BMat whose columns form a basis for the column space of \c
+    //! this.
+    //!
+    //! This is the transpose of the BMat::row_space_basis of the transpose
+    //! of \c this.
+    BMat col_space_basis() const {
+      return transpose().row_space_basis().transpose();
+    }
+
+    //! Returns the size of the row space of \c this.
+    //!
+    //! The row space includes the zero row, i.e. the empty union of rows.
+    //! The basis vectors are split into classes of vectors that are
+    //! connected by non-empty intersections, and the size of the row space is
+    //! the product of the numbers of unions of the vectors in each class.
+    //! These unions are enumerated one at a time, using \f$O(N)\f$ memory,
+    //! and so this method is only practical when every such class has a
+    //! small number of unions; this number can be as large as
+    //! \f$2 ^ k\f$ for a class of \f$k\f$ vectors. The only row space
+    //! whose size does not fit in a \c size_t is that of a BMat64 whose
+    //! basis consists of all 64 rows with a single 1, and for this matrix
+    //! this method returns 0.
+    size_t row_space_size() const {
+      BMat const basis   = row_space_basis();
+      size_t     nr_rows = 0;
+      while (nr_rows < N && basis._rows[nr_rows] != 0) {
+        ++nr_rows;
+      }
+      // Sort the basis vectors into classes of vectors connected by
+      // non-empty intersections, and multiply the numbers of unions of the
+      // vectors in each class.
+      row_type rows[N];
+      bool     used[N] = {false};
+      size_t   size    = 1;
+      for (size_t i = 0; i < nr_rows; ++i) {
+        if (used[i]) {
+          continue;
+        }
+        used[i]         = true;
+        rows[0]         = basis._rows[i];
+        size_t   nr     = 1;
+        row_type cup    = basis._rows[i];
+        bool     change = true;
+        while (change) {
+          change = false;
+          for (size_t j = i + 1; j < nr_rows; ++j) {
+            if (!used[j] && (basis._rows[j] & cup) != 0) {
+              used[j]    = true;
+              rows[nr++] = basis._rows[j];
+              cup |= basis._rows[j];
+              change = true;
+            }
+          }
+        }
+        size *= nr_unions(rows, nr, 0, 0);
+      }
+      return size;
+    }
+
+    //! Returns the size of the column space of \c this.
+    //!
+    //! See BMat::row_space_size for details.
+    size_t col_space_size() const {
+      return transpose().row_space_size();
+    }
+
+    //! Returns a hash value for \c this.
+    //!
+    //! Unless libsemigroups is configured with \c --disable-mixhash, this
+    //! method uses hash_bytes, and otherwise the rows of \c this are
+    //! combined one at a time.
+    size_t hash_value() const {
+#ifdef LIBSEMIGROUPS_USE_MIXHASH
+      return hash_bytes(_rows, sizeof(_rows));
+#else
+      size_t seed = 0;
+      for (size_t i = 0; i < N; ++i) {
+        seed ^= static_cast<size_t>(_rows[i]) + 0x9e3779b97f4a7c15
+                + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+#endif
+    }
+
+#if defined(LIBSEMIGROUPS_HAVE_DENSEHASHMAP) \
+    && defined(LIBSEMIGROUPS_USE_DENSEHASHMAP)
+    //! Returns the empty key for google's dense_hash_map.
+    //!
+    //! This is the BMat all of whose entries are 1, as BMat8(-1) is for
+    //! BMat8, and so this matrix must not be an element of a Semigroup<BMat>
+    //! when libsemigroups is configured with \c --enable-densehashmap.
+    BMat empty_key() const {
+      BMat key;
+      for (size_t i = 0; i < N; ++i) {
+        key._rows[i] = ~row_type(0);
+      }
+      return key;
+    }
+#endif
+
+    //! Insertion operator
+    //!
+    //! This method allows BMat objects to be inserted into an ostringstream
+    friend std::ostringstream& operator<<(std::ostringstream& os,
+                                          BMat const&         bm) {
+      for (size_t i = 0; i < N; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+          os << (bm(i, j) ? "1" : "0");
+        }
+        os << "\n";
+      }
+      return os;
+    }
+
+    //! Insertion operator
+    //!
+    //! This method allows BMat objects to be inserted into a ostream.
+    friend std::ostream& operator<<(std::ostream& os, BMat const& bm) {
+      std::ostringstream oss;
+      oss << bm;
+      os << oss.str();
+      return os;
+    }
+
+   private:
+    // Returns the number of unions w of u and some of rows[start], ...,
+    // rows[nr_rows - 1] such that every rows[j] with j < start that is
+    // contained in w is also contained in u. Each such w is counted once,
+    // below the smallest i >= start such that rows[i] is contained in w but
+    // not in u (this is the NextClosure algorithm of Ganter).
+    static size_t nr_unions(row_type const* rows,
+                            size_t          nr_rows,
+                            size_t          start,
+                            row_type        u) {
+      size_t nr = 1;
+      for (size_t i = start; i < nr_rows; ++i) {
+        if ((rows[i] | u) == u) {
+          continue;
+        }
+        row_type const v         = u | rows[i];
+        bool           canonical = true;
+        for (size_t j = 0; j < i && canonical; ++j) {
+          canonical = ((rows[j] | v) != v || (rows[j] | u) == u);
+        }
+        if (canonical) {
+          nr += nr_unions(rows, nr_rows, i + 1, v);
+        }
+      }
+      return nr;
+    }
+
+    static constexpr row_type LOW_HALF
+        = static_cast<row_type>(~row_type(0)) >> (N / 2);
+
+    static inline row_type bit(size_t j) {
+      return static_cast<row_type>(row_type(1) << (N - j - 1));
+    }
+
+    row_type _rows[N];
+  };
+
+  //! Type for fast boolean matrices of dimension up to 16 x 16.
+  typedef BMat<16> BMat16;
+
+  //! Type for fast boolean matrices of dimension up to 32 x 32.
+  typedef BMat<32> BMat32;
+
+  //! Type for fast boolean matrices of dimension up to 64 x 64.
+  typedef BMat<64> BMat64;
+
+  static_assert(std::is_trivial<BMat64>(), "BMat is not a trivial class!");
+}  // namespace libsemigroups
+
+namespace std {
+  template <size_t N> struct hash<libsemigroups::BMat<N>> {
+    size_t operator()(libsemigroups::BMat<N> const& bm) const {
+      return bm.hash_value();
+    }
+  };
+}  // namespace std
+#endif  // LIBSEMIGROUPS_SRC_BMAT_H_
@@ -21,10 +21,16 @@
 
 #include "bmat8.h"
 
+#include <algorithm>
+#include <bitset>
 #include <random>
 #include <string>
 #include <vector>
 
+#if defined(LIBSEMIGROUPS_USE_AVX2) && defined(__AVX2__)
+#include <x86intrin.h>
+#endif
+
 namespace libsemigroups {
   static_assert(std::is_trivial<BMat8>(), "BMat8 is not a trivial class!");
   std::vector<uint64_t> const BMat8::ROW_MASK = {0xff00000000000000,
@@ -132,6 +138,243 @@ namespace libsemigroups {
     }
   }
 
+  BMat8 BMat8::row_space_basis() const {
+    // For every row of this, compute the union of the other rows that are
+    // properly contained in it. The rows of this, cyclically shifted by k
+    // rows, are compared with the rows of this all at once.
+    uint64_t cup = 0;
+    for (size_t k = 1; k < 8; ++k) {
+      uint64_t const y = cyclic_shift(_data, k);
+      cup |= y & ~nonzero_rows(y & ~_data) & nonzero_rows(y ^ _data);
+    }
+    // A row of this belongs to the basis if and only if it is not the union
+    // of the rows it properly contains; this excludes the zero rows.
+    uint64_t const basis = _data & nonzero_rows(cup ^ _data);
+
+    // Sort the rows of basis in decreasing order, removing duplicates.
+    uint8_t rows[8];
+    for (size_t i = 0; i < 8; ++i) {
+      rows[i] = basis >> (56 - 8 * i);
+    }
+    std::sort(rows, rows + 8, std::greater<uint8_t>());
+    uint64_t data = 0;
+    size_t   next = 0;
+    for (size_t i = 0; i < 8 && rows[i] != 0; ++i) {
+      if (i == 0 || rows[i] != rows[i - 1]) {
+        data |= static_cast<uint64_t>(rows[i]) << (56 - 8 * next++);
+      }
+    }
+    return BMat8(data);
+  }
+
+  size_t BMat8::row_space_size() const {
+    // The row space is stored as a set of 256 bits, the v-th of which is
+    // set if v belongs to the row space. The set of unions v | row, for v in
+    // the row space, is obtained by setting the bits of row one at a time,
+    // which moves the v-th bit of the set to position v + 2 ^ b for every
+    // v not containing bit b.
+    //
+    // The set fits in one AVX2 register, but a version keeping it there, with
+    // lane permutes for the bits 6 and 7, was slower than using four words.
+    static uint64_t const MASK[6] = {0xaaaaaaaaaaaaaaaa,
+                                     0xcccccccccccccccc,
+                                     0xf0f0f0f0f0f0f0f0,
+                                     0xff00ff00ff00ff00,
+                                     0xffff0000ffff0000,
+                                     0xffffffff00000000};
+    uint64_t space[4] = {1, 0, 0, 0};
+    for (size_t i = 0; i < 8; ++i) {
+      uint8_t const row = _data >> (56 - 8 * i);
+      if (row == 0) {
+        continue;
+      }
+      uint64_t t[4] = {space[0], space[1], space[2], space[3]};
+      for (size_t b = 0; b < 6; ++b) {
+        if ((row >> b) & 1) {
+          for (size_t w = 0; w < 4; ++w) {
+            t[w] = (t[w] & MASK[b]) | ((t[w] & ~MASK[b]) << (1 << b));
+          }
+        }
+      }
+      if (row & 0x40) {
+        t[1] |= t[0];
+        t[3] |= t[2];
+        t[0] = t[2] = 0;
+      }
+      if (row & 0x80) {
+        t[2] |= t[0];
+        t[3] |= t[1];
+        t[0] = t[1] = 0;
+      }
+      for (size_t w = 0; w < 4; ++w) {
+        space[w] |= t[w];
+      }
+    }
+    size_t count = 0;
+    for (size_t w = 0; w < 4; ++w) {
+      count += std::bitset<64>(space[w]).count();
+    }
+    return count;
+  }
+
+  bool BMat8::row_space_included(BMat8 const& that) const {
+    // The rows of that contained in each row of this, for every cyclic
+    // shift of the rows of that.
+    uint64_t cup = 0;
+    for (size_t k = 0; k < 8; ++k) {
+      uint64_t const y = cyclic_shift(that._data, k);
+      cup |= y & ~nonzero_rows(y & ~_data);
+    }
+    return cup == _data;
+  }
+
+  // Returns the integer whose bytes are 0xff where the j-th column of x is
+  // 1, and 0 where it is 0.
+  static inline uint64_t expand_col(uint64_t x, size_t j) {
+    return (((x << j) & 0x8080808080808080) >> 7) * 0xff;
+  }
+
+  // Returns the integer all of whose bytes equal the j-th row of x.
+  static inline uint64_t expand_row(uint64_t x, size_t j) {
+    return ((x >> (56 - 8 * j)) & 0xff) * 0x0101010101010101;
+  }
+
+#if defined(LIBSEMIGROUPS_USE_AVX2) && defined(__AVX2__)
+  // The batch methods below process four BMat8s at a time, one in each
+  // 64-bit lane of an AVX2 register, and the remaining ones as in the
+  // scalar versions.
+
+  // Returns the AVX2 register all of whose 64-bit lanes equal x.
+  static inline __m256i broadcast(uint64_t x) {
+    return _mm256_set1_epi64x(static_cast<int64_t>(x));
+  }
+
+  // Returns the byte shuffle that copies the j-th row, i.e. the (7 - j)-th
+  // byte, of each 64-bit lane to every byte of that lane.
+  static inline __m256i expand_row_shuffle(size_t j) {
+    int64_t const lo = static_cast<int64_t>((7 - j) * 0x0101010101010101);
+    int64_t const hi = static_cast<int64_t>((15 - j) * 0x0101010101010101);
+    return _mm256_set_epi64x(hi, lo, hi, lo);
+  }
+
+  static inline __m256i load(BMat8 const* in) {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in));
+  }
+
+  static inline void store(BMat8* out, __m256i x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), x);
+  }
+#endif
+
+  void BMat8::multiply_left(BMat8 const& x,
+                            BMat8 const* in,
+                            BMat8*       out,
+                            size_t       n) {
+    // The i-th row of x * y is the union of the rows of y indexed by the
+    // entries of the i-th row of x.
+    uint64_t cols[8];
+    for (size_t j = 0; j < 8; ++j) {
+      cols[j] = expand_col(x._data, j);
+    }
+    size_t i = 0;
+#if defined(LIBSEMIGROUPS_USE_AVX2) && defined(__AVX2__)
+    __m256i cols4[8], shuffle[8];
+    for (size_t j = 0; j < 8; ++j) {
+      cols4[j]   = broadcast(cols[j]);
+      shuffle[j] = expand_row_shuffle(j);
+    }
+    for (; i + 4 <= n; i += 4) {
+      __m256i const y    = load(in + i);
+      __m256i       data = _mm256_setzero_si256();
+      for (size_t j = 0; j < 8; ++j) {
+        __m256i const row = _mm256_shuffle_epi8(y, shuffle[j]);
+        data = _mm256_or_si256(data, _mm256_and_si256(cols4[j], row));
+      }
+      store(out + i, data);
+    }
+#endif
+    for (; i < n; ++i) {
+      uint64_t const y    = in[i]._data;
+      uint64_t       data = 0;
+      for (size_t j = 0; j < 8; ++j) {
+        data |= cols[j] & expand_row(y, j);
+      }
+      out[i]._data = data;
+    }
+  }
+
+  void BMat8::multiply_right(BMat8 const& x,
+                             BMat8 const* in,
+                             BMat8*       out,
+                             size_t       n) {
+    uint64_t rows[8];
+    for (size_t j = 0; j < 8; ++j) {
+      rows[j] = expand_row(x._data, j);
+    }
+    size_t i = 0;
+#if defined(LIBSEMIGROUPS_USE_AVX2) && defined(__AVX2__)
+    // The j-th column of y is expanded by comparing the bytes of y, masked
+    // by the j-th bit of a row, with that bit.
+    __m256i rows4[8], bits[8];
+    for (size_t j = 0; j < 8; ++j) {
+      rows4[j] = broadcast(rows[j]);
+      bits[j]  = _mm256_set1_epi8(static_cast<char>(0x80 >> j));
+    }
+    for (; i + 4 <= n; i += 4) {
+      __m256i const y    = load(in + i);
+      __m256i       data = _mm256_setzero_si256();
+      for (size_t j = 0; j < 8; ++j) {
+        __m256i const col
+            = _mm256_cmpeq_epi8(_mm256_and_si256(y, bits[j]), bits[j]);
+        data = _mm256_or_si256(data, _mm256_and_si256(col, rows4[j]));
+      }
+      store(out + i, data);
+    }
+#endif
+    for (; i < n; ++i) {
+      uint64_t const y    = in[i]._data;
+      uint64_t       data = 0;
+      for (size_t j = 0; j < 8; ++j) {
+        data |= expand_col(y, j) & rows[j];
+      }
+      out[i]._data = data;
+    }
+  }
+
+  void BMat8::transpose(BMat8 const* in, BMat8* out, size_t n) {
+    size_t i = 0;
+#if defined(LIBSEMIGROUPS_USE_AVX2) && defined(__AVX2__)
+    // The same swaps as in BMat8::transpose, in every lane.
+    __m256i const m1 = broadcast(0xAA00AA00AA00AA);
+    __m256i const m2 = broadcast(0xCCCC0000CCCC);
+    __m256i const m3 = broadcast(0xF0F0F0F0);
+    for (; i + 4 <= n; i += 4) {
+      __m256i x = load(in + i);
+      __m256i y
+          = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x, 7)), m1);
+      x = _mm256_xor_si256(_mm256_xor_si256(x, y), _mm256_slli_epi64(y, 7));
+      y = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x, 14)), m2);
+      x = _mm256_xor_si256(_mm256_xor_si256(x, y), _mm256_slli_epi64(y, 14));
+      y = _mm256_and_si256(_mm256_xor_si256(x, _mm256_srli_epi64(x, 28)), m3);
+      x = _mm256_xor_si256(_mm256_xor_si256(x, y), _mm256_slli_epi64(y, 28));
+      store(out + i, x);
+    }
+#endif
+    for (; i < n; ++i) {
+      out[i] = in[i].transpose();
+    }
+  }
+
+  void BMat8::hash(BMat8 const* in, size_t* out, size_t n) {
+    // There is no AVX2 version of this loop. The value of std::hash<uint64_t>
+    // is implementation defined; in libstdc++ it is the argument itself, and
+    // the compiler already turns this loop into vector copies.
+    std::hash<BMat8> hasher;
+    for (size_t i = 0; i < n; ++i) {
+      out[i] = hasher(in[i]);
+    }
+  }
+
   BMat8 BMat8::random() {
     return BMat8(_dist(_gen));
   }
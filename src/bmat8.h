@@ -192,6 +192,53 @@ namespace libsemigroups {
       return BMat8(0x8040201008040201);
     }
 
+    //! Returns a BMat8 whose rows form a basis for the row space of \c this.
+    //!
+    //! The row space of a boolean matrix is the set of all unions of its
+    //! rows, and its basis is the unique set of non-zero rows that are not
+    //! unions of other rows. The rows of the returned matrix are the basis
+    //! vectors, in decreasing order, followed by zero rows. Hence two BMat8
+    //! objects have the same row space if and only if their row space bases
+    //! are equal, and the row space basis is a canonical representative of
+    //! the row space.
+    BMat8 row_space_basis() const;
+
+    //! Returns a BMat8 whose columns form a basis for the column space of
+    //! \c this.
+    //!
+    //! This is the transpose of the BMat8::row_space_basis of the transpose
+    //! of \c this.
+    BMat8 col_space_basis() const {
+      return transpose().row_space_basis().transpose();
+    }
+
+    //! Returns the size of the row space of \c this.
+    //!
+    //! The row space includes the zero row, i.e. the empty union of rows.
+    size_t row_space_size() const;
+
+    //! Returns the size of the column space of \c this.
+    //!
+    //! See BMat8::row_space_size for details.
+    size_t col_space_size() const {
+      return transpose().row_space_size();
+    }
+
+    //! Returns \c true if the row space of \c this is contained in that of
+    //! \p that.
+    //!
+    //! This method checks that every row of \c this is the union of the rows
+    //! of \p that which it contains, without computing either row space.
+    bool row_space_included(BMat8 const& that) const;
+
+    //! Returns \c true if \c this and \p that have the same row space.
+    //!
+    //! This is faster than comparing the row space bases of \c this and
+    //! \p that, see BMat8::row_space_included.
+    bool row_space_equal(BMat8 const& that) const {
+      return row_space_included(that) && that.row_space_included(*this);
+    }
+
     //! Insertion operator
     //!
     //! This method allows BMat8 objects to be inserted into an ostringstream
@@ -222,6 +269,43 @@ namespace libsemigroups {
       return os;
     }
 
+    //! Multiplies \p x by each of \p in[0], ..., \p in[n - 1] on the right.
+    //!
+    //! This method stores \p x * \p in[i] in \p out[i] for every \c i less
+    //! than \p n. The columns of \p x are expanded once, so that each
+    //! product only requires a few operations per row, and no transposes.
+    //! The arrays \p in and \p out may be equal, but must not otherwise
+    //! overlap. Unless libsemigroups is configured with \c --disable-avx2,
+    //! or AVX2 is not available, four products are computed at a time.
+    static void
+    multiply_left(BMat8 const& x, BMat8 const* in, BMat8* out, size_t n);
+
+    //! Multiplies \p x by each of \p in[0], ..., \p in[n - 1] on the left.
+    //!
+    //! This method stores \p in[i] * \p x in \p out[i] for every \c i less
+    //! than \p n. The rows of \p x are expanded once, so that each product
+    //! only requires a few operations per row, and no transposes. The arrays
+    //! \p in and \p out may be equal, but must not otherwise overlap. Unless
+    //! libsemigroups is configured with \c --disable-avx2, or AVX2 is not
+    //! available, four products are computed at a time.
+    static void
+    multiply_right(BMat8 const& x, BMat8 const* in, BMat8* out, size_t n);
+
+    //! Transposes each of \p in[0], ..., \p in[n - 1].
+    //!
+    //! This method stores the transpose of \p in[i] in \p out[i] for every
+    //! \c i less than \p n. The arrays \p in and \p out may be equal, but
+    //! must not otherwise overlap. Unless libsemigroups is configured with
+    //! \c --disable-avx2, or AVX2 is not available, four matrices are
+    //! transposed at a time.
+    static void transpose(BMat8 const* in, BMat8* out, size_t n);
+
+    //! Hashes each of \p in[0], ..., \p in[n - 1].
+    //!
+    //! This method stores the value of std::hash<BMat8> for \p in[i] in
+    //! \p out[i] for every \c i less than \p n.
+    static void hash(BMat8 const* in, size_t* out, size_t n);
+
     //! Returns a random BMat8
     //!
     //! This method returns a BMat8 chosen at random.
@@ -242,6 +326,15 @@ namespace libsemigroups {
     static std::vector<uint64_t> const           COL_MASK;
     static std::vector<uint64_t> const           BIT_MASK;
 
+    // Returns the integer whose bytes are 0xff where the bytes, i.e. rows, of
+    // x are non-zero, and 0 where they are zero.
+    static inline uint64_t nonzero_rows(uint64_t x) {
+      x |= x >> 4;
+      x |= x >> 2;
+      x |= x >> 1;
+      return (x & 0x0101010101010101) * 0xff;
+    }
+
     // Cyclically shifts bits to left by 8m
     // https://stackoverflow.com/a/776523
     static inline uint64_t cyclic_shift(uint64_t n, uint64_t m = 1) {
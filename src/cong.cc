@@ -19,12 +19,16 @@
 #include "cong.h"
 
 #include <algorithm>
+#include <chrono>
 #include <thread>
 
 #include "cong/kbfp.cc"
 #include "cong/kbp.cc"
+#include "cong/kbtc.cc"
 #include "cong/p.h"
 #include "cong/tc.cc"
+#include "rws.h"
+#include "rwse.h"
 
 namespace libsemigroups {
 
@@ -50,6 +54,8 @@ namespace libsemigroups {
                          std::vector<relation_t> const& extra)
       : _data(nullptr),
         _extra(extra),
+        _kb_done(false),
+        _kb_rws(nullptr),
         _max_threads(std::thread::hardware_concurrency()),
         _nrgens(nrgens),
         _prefill(),
@@ -83,6 +89,58 @@ namespace libsemigroups {
                          std::vector<relation_t> const& extra)
       : Congruence(type_from_string(type), semigroup, extra) {}
 
+  Congruence::~Congruence() {
+    // The data may use _kb_rws, and so it is deleted first.
+    delete_data();
+    delete _kb_rws;
+  }
+
+  RWS* Congruence::kb_rws(std::atomic<bool>& killed) {
+    while (!_kb_done && !killed) {
+      if (_kb_mtx.try_lock()) {
+        if (!_kb_done) {
+          if (_kb_rws == nullptr) {
+            init_relations(_semigroup, killed);
+            if (!killed) {
+              _kb_rws = new RWS(new SHORTLEX(), rws_alphabet(_nrgens));
+              _kb_rws->add_rules(_relations);
+            }
+          }
+          if (_kb_rws != nullptr) {
+            REPORT("running Knuth-Bendix . . .");
+            // If this is killed, then Knuth-Bendix is resumed by the next
+            // caller.
+            _kb_rws->knuth_bendix(killed);
+            if (!killed) {
+              // Compute the links of the rule trie and the normal forms
+              // automaton of _kb_rws now, while holding _kb_mtx, so that the
+              // callers of this method only ever read _kb_rws, and can do so
+              // concurrently.
+              _kb_rws->nr_normal_forms(1, RWS::UNBOUNDED);
+              _kb_done = true;
+            }
+          }
+        }
+        _kb_mtx.unlock();
+      } else {
+        // Another thread is running Knuth-Bendix
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    return (_kb_done ? _kb_rws : nullptr);
+  }
+
+  Semigroup<RWSE*>* Congruence::new_kb_semigroup() {
+    LIBSEMIGROUPS_ASSERT(_kb_done);
+    std::vector<RWSE*> gens;
+    for (size_t i = 0; i < _nrgens; i++) {
+      gens.push_back(new RWSE(*_kb_rws, i));
+    }
+    Semigroup<RWSE*>* semigroup = new Semigroup<RWSE*>(gens);
+    really_delete_cont(gens);
+    return semigroup;
+  }
+
   Congruence::DATA* Congruence::winning_data(
       std::vector<Congruence::DATA*>&                      data,
       std::vector<std::function<void(Congruence::DATA*)>>& funcs,
@@ -217,6 +275,7 @@ namespace libsemigroups {
         // TC will be invalid/useless in certain cases; we check these here.
         if (!is_obviously_infinite()) {
           data.push_back(new TC(*this));
+          data.push_back(new KBTC(*this));
         }
         winner = winning_data(data, funcs, true, goal_func);
       }
@@ -319,6 +378,12 @@ namespace libsemigroups {
     _data = new KBFP(*this);
   }
 
+  void Congruence::force_kbtc() {
+    LIBSEMIGROUPS_ASSERT(!is_obviously_infinite());
+    delete_data();
+    _data = new KBTC(*this);
+  }
+
   Partition<word_t>* Congruence::nontrivial_classes() {
     DATA* data;
     if (_semigroup == nullptr) {
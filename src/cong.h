@@ -35,6 +35,9 @@
 
 namespace libsemigroups {
 
+  class RWS;
+  class RWSE;
+
   //! Class for congruence on a semigroup or fintely presented semigroup.
   //!
   //! This class represents a congruence on a semigroup defined either as an
@@ -134,9 +137,7 @@ namespace libsemigroups {
     //!
     //! The caller is responsible for deleting the semigroup used to construct
     //! \c this, if any.
-    ~Congruence() {
-      delete_data();
-    }
+    ~Congruence();
 
     //! Returns the index of the congruence class corresponding to \p word.
     //!
@@ -409,11 +410,18 @@ namespace libsemigroups {
     //! This method only applies to a congruence created using a Semigroup
     //! object, and does not apply to finitely presented semigroups.
     //!
+    //! If the Semigroup over which \c this is defined is already fully
+    //! enumerated when this method is called, then pairs of positions of
+    //! elements are enumerated using the left and right Cayley graphs of the
+    //! Semigroup, and no elements are multiplied. In this case, the space
+    //! complexity is linear in the size of the Semigroup.
+    //!
     //! \warning Any existing data for the congruence is deleted by this
     //! method, and may have to be recomputed. The return values and runtimes
     //! of other methods applied to \c this may also be affected.
     //!
-    //! \warning The worst case space complexity of these algorithms
+    //! \warning If the Semigroup over which \c this is defined is not fully
+    //! enumerated, then the worst case space complexity of these algorithms
     //! is the square of the size of the semigroup over which \c this is
     //! defined.
     void force_p();
@@ -474,6 +482,29 @@ namespace libsemigroups {
     //! a finitely presented semigroup.
     void force_kbfp();
 
+    //! Use the Knuth-Bendix algorithm for a bounded number of rules on a
+    //! rewriting system RWS with rules obtained from Congruence::relations,
+    //! followed by the Todd-Coxeter algorithm.
+    //!
+    //! This method forces the use of the [Knuth-Bendix
+    //! algorithm](https://en.wikipedia.org/wiki/Knuth–Bendix_completion_algorithm)
+    //! until the rewriting system has a certain number of rules, or is
+    //! confluent, followed by the [Todd-Coxeter
+    //! algorithm](https://en.wikipedia.org/wiki/Todd–Coxeter_algorithm).
+    //! The Todd-Coxeter algorithm is applied to the rules of the rewriting
+    //! system, and to Congruence::relations, with each side rewritten using
+    //! these rules, rather than to Congruence::relations only. Since the
+    //! rewriting system need not be confluent, this can be applied to left,
+    //! right, and two-sided congruences.
+    //!
+    //! \warning Any existing data for the congruence is deleted by this
+    //! method, and may have to be recomputed. The return values and runtimes
+    //! of other methods applied to \c this may also be affected.
+    //!
+    //! \warning The Todd-Coxeter Algorithm may never terminate when applied to
+    //! a finitely presented semigroup.
+    void force_kbtc();
+
     //! This method tries to quickly determine whether or not the Congruence
     //! has infinitely many classes.
     //!
@@ -486,6 +517,7 @@ namespace libsemigroups {
     // Subclasses of DATA
     class KBFP;  // Knuth-Bendix followed by Froidure-Pin
     class KBP;   // Knuth-Bendix followed by P
+    class KBTC;  // Knuth-Bendix followed by Todd-Coxeter
     template <typename TElementType,
               typename TElementHash,
               typename TElementEqual>
@@ -497,6 +529,7 @@ namespace libsemigroups {
     class DATA {
       friend KBFP;
       friend KBP;
+      friend KBTC;
       template <typename TElementType,
                 typename TElementHash,
                 typename TElementEqual>
@@ -633,6 +666,21 @@ namespace libsemigroups {
       init_relations(semigroup, killed);
     }
 
+    // Returns a confluent rewriting system whose rules are the relations of
+    // the Congruence, or nullptr if killed. Knuth-Bendix is run for these
+    // relations at most once, by the first of the KBFP and KBP objects to call
+    // this, and any other callers wait for it to finish, or to be killed, and
+    // the result is shared by all of them.
+    RWS* kb_rws(std::atomic<bool>& killed);
+
+    // Returns a new Semigroup of RWSE's whose elements are the normal forms of
+    // the rewriting system returned by kb_rws, which must not be nullptr. The
+    // caller must delete the returned semigroup. Every caller gets its own
+    // semigroup, since a Semigroup cannot be enumerated in one thread while
+    // it is used in another, but they all share the rewriting system, which
+    // they only read.
+    Semigroup<RWSE*>* new_kb_semigroup();
+
     DATA* cget_data() const {
       return _data;
     }
@@ -658,6 +706,9 @@ namespace libsemigroups {
     DATA*                   _data;
     std::vector<relation_t> _extra;
     std::mutex              _init_mtx;
+    std::atomic<bool>       _kb_done;
+    std::mutex              _kb_mtx;
+    RWS*                    _kb_rws;
     std::mutex              _kill_mtx;
     size_t                  _max_threads;
     size_t                  _nrgens;
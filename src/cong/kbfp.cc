@@ -36,31 +36,83 @@
 
 namespace libsemigroups {
 
+  // Returns the alphabet of a rewriting system with <n> letters, which are
+  // the letters of the words RWS::uint_to_rws_word(i) for i < n, so that RWS
+  // counts the normal forms over all of these letters, and not only those
+  // which appear in the relations.
+  static std::string rws_alphabet(size_t n) {
+    std::string alphabet;
+    for (size_t i = 0; i < n; i++) {
+      RWS::rws_word_t* w = RWS::uint_to_rws_word(i);
+      alphabet += *w;
+      delete w;
+    }
+    return alphabet;
+  }
+
+  Congruence::KBFP::KBFP(Congruence& cong)
+      : DATA(cong, 200),
+        _nr_classes(UNDEFINED),
+        _rws(nullptr),
+        _semigroup(nullptr) {}
+
   void Congruence::KBFP::init() {
     if (_semigroup != nullptr) {
       return;
-    } else if (_rws->nr_rules() == 0) {
-      _cong.init_relations(_cong._semigroup, _killed);
-      _rws->add_rules(_cong.relations());
-      _rws->add_rules(_cong.extra());
     }
 
     LIBSEMIGROUPS_ASSERT(_cong._semigroup == nullptr || !_cong.extra().empty());
 
-    REPORT("running Knuth-Bendix . . .")
-    _rws->knuth_bendix(_killed);
-    if (_killed) {
+    // The confluent rewriting system for the relations is shared with KBP
+    RWS* rws = _cong.kb_rws(_killed);
+    if (rws == nullptr) {
       REPORT("killed");
       return;
+    } else if (_cong.extra().empty()) {
+      // The semigroup defined by the relations is the quotient.
+      _rws       = rws;
+      _semigroup = _cong.new_kb_semigroup();
+    } else {
+      if (_rws == nullptr) {
+        // Start from the rules of rws, rather than the relations, so that
+        // Knuth-Bendix for the relations is not run again.
+        _rws = new RWS(new SHORTLEX(), rws_alphabet(_cong._nrgens));
+        for (auto const& rule : rws->rules()) {
+          _rws->add_rule(rule.first, rule.second);
+        }
+        _rws->add_rules(_cong.extra());
+      }
+      REPORT("running Knuth-Bendix . . .")
+      _rws->knuth_bendix(_killed);
+      if (_killed) {
+        REPORT("killed");
+        return;
+      }
+
+      LIBSEMIGROUPS_ASSERT(_rws->confluent());
+      std::vector<RWSE*> gens;
+      for (size_t i = 0; i < _cong._nrgens; i++) {
+        gens.push_back(new RWSE(*_rws, i));
+      }
+      _semigroup = new Semigroup<RWSE*>(gens);
+      really_delete_cont(gens);
     }
 
-    LIBSEMIGROUPS_ASSERT(_rws->confluent());
-    std::vector<RWSE*> gens;
-    for (size_t i = 0; i < _cong._nrgens; i++) {
-      gens.push_back(new RWSE(*_rws, i));
+    // The elements of _semigroup are the non-empty normal forms and the empty
+    // word if it is the normal form of a non-empty word, i.e. if there is a
+    // rule with empty right hand side. If there are finitely many of these,
+    // then we do not have to enumerate _semigroup to count them.
+    size_t nr = _rws->nr_normal_forms(1, RWS::UNBOUNDED);
+    if (nr != RWS::UNBOUNDED) {
+      for (auto const& rule : _rws->rules()) {
+        if (rule.second.empty()) {
+          nr++;
+          break;
+        }
+      }
+      REPORT("found " << nr << " classes using the normal forms");
+      _nr_classes = nr;
     }
-    _semigroup = new Semigroup<RWSE*>(gens);
-    really_delete_cont(gens);
   }
 
   void Congruence::KBFP::run() {
@@ -74,7 +126,7 @@ namespace libsemigroups {
 
     init();
 
-    if (!_killed) {
+    if (!_killed && !is_done()) {
       REPORT("running Froidure-Pin . . .")
       // This if statement will never be entered - see top of file for details
       if (steps != Congruence::LIMIT_MAX) {
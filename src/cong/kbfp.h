@@ -34,23 +34,29 @@ namespace libsemigroups {
   // Knuth-Bendix followed by Froidure-Pin
   class Congruence::KBFP : public Congruence::DATA {
    public:
-    explicit KBFP(Congruence& cong)
-        : DATA(cong, 200), _rws(new RWS()), _semigroup(nullptr) {}
+    explicit KBFP(Congruence& cong);
 
     ~KBFP() {
-      delete _rws;
+      // _rws may be shared with KBP, and owned by _cong
       delete _semigroup;
+      if (_rws != _cong._kb_rws) {
+        delete _rws;
+      }
     }
 
     void run() final;
     void run(size_t steps) final;
 
     bool is_done() const final {
-      return (_semigroup != nullptr && _semigroup->is_done());
+      return (_nr_classes != UNDEFINED
+              || (_semigroup != nullptr && _semigroup->is_done()));
     }
 
     size_t nr_classes() final {
       LIBSEMIGROUPS_ASSERT(is_done());
+      if (_nr_classes != UNDEFINED) {
+        return _nr_classes;
+      }
       return _semigroup->size();
     }
 
@@ -61,6 +67,8 @@ namespace libsemigroups {
    private:
     void init();
 
+    // The number of classes if it is known without enumerating _semigroup.
+    size_t            _nr_classes;
     RWS*              _rws;
     Semigroup<RWSE*>* _semigroup;
   };
@@ -35,20 +35,13 @@ namespace libsemigroups {
     }
     LIBSEMIGROUPS_ASSERT(_P_cong == nullptr);
 
-    // Initialise the rewriting system
-    _rws->add_rules(_cong.relations());
-    REPORT("running Knuth-Bendix . . .");
-    _rws->knuth_bendix(_killed);
+    // The confluent rewriting system for the relations is shared with KBFP.
+    RWS* rws = _cong.kb_rws(_killed);
 
     // Setup the P cong
-    if (!_killed) {
-      LIBSEMIGROUPS_ASSERT(_rws->confluent());
-      std::vector<RWSE*> gens;
-      for (size_t i = 0; i < _cong._nrgens; i++) {
-        gens.push_back(new RWSE(*_rws, i));
-      }
-      _semigroup = new Semigroup<RWSE*>(gens);
-      really_delete_cont(gens);
+    if (rws != nullptr) {
+      LIBSEMIGROUPS_ASSERT(rws->confluent());
+      _semigroup = _cong.new_kb_semigroup();
 
       _P_cong = new Congruence(_cong._type, _semigroup, _cong._extra);
       _P_cong->set_relations(_cong.relations());
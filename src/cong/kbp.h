@@ -36,15 +36,12 @@ namespace libsemigroups {
   class Congruence::KBP : public Congruence::DATA {
    public:
     explicit KBP(Congruence& cong)
-        : DATA(cong, 200),
-          _rws(new RWS()),
-          _semigroup(nullptr),
-          _P_cong(nullptr) {}
+        : DATA(cong, 200), _semigroup(nullptr), _P_cong(nullptr) {}
 
     ~KBP() {
-      delete _rws;
-      delete _semigroup;
+      // _P_cong uses _semigroup, and so it is deleted first.
       delete _P_cong;
+      delete _semigroup;
     }
 
     void run() final;
@@ -67,7 +64,6 @@ namespace libsemigroups {
    private:
     void init();
 
-    RWS*              _rws;
     Semigroup<RWSE*>* _semigroup;
     Congruence*       _P_cong;
   };
@@ -0,0 +1,83 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2017 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains implementations for the private inner class of Congruence
+// called KBTC, which is a subclass of Congruence::TC.  This class is for
+// performing Knuth-Bendix, for a bounded number of rules, followed by the
+// Todd-Coxeter algorithm.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../rws.h"
+#include "kbtc.h"
+
+namespace libsemigroups {
+
+  // The maximum number of rules which Knuth-Bendix can add to the rewriting
+  // system, every rule is traced from every coset by Todd-Coxeter, and so
+  // there should not be too many of them.
+  static size_t const KBTC_MAX_NEW_RULES = 16;
+
+  // Every active rule of a rewriting system is a consequence of the relations
+  // used to define it, and every relation (u, v) is a consequence of the
+  // active rules and the relation obtained by rewriting u and v, whether or
+  // not the system is confluent. Hence the rules and the rewritten relations
+  // define the same congruence as the relations of the enclosing Congruence,
+  // even if Knuth-Bendix is killed.
+  void Congruence::KBTC::add_cong_relations() {
+    _cong.init_relations(_cong._semigroup, _killed);
+
+    RWS rws;
+    rws.add_rules(_cong._relations);
+    rws.set_max_rules(rws.nr_rules() + KBTC_MAX_NEW_RULES);
+    REPORT("running Knuth-Bendix . . .");
+    rws.knuth_bendix(_killed);
+    if (_killed) {
+      REPORT("killed");
+    }
+
+    for (auto const& rule : rws.rules()) {
+      word_t* lhs = RWS::rws_word_to_word(&rule.first);
+      word_t* rhs = RWS::rws_word_to_word(&rule.second);
+      _relations.emplace_back(std::move(*lhs), std::move(*rhs));
+      delete lhs;
+      delete rhs;
+    }
+    size_t const nr_rules = _relations.size();
+
+    std::string u;
+    std::string v;
+    for (relation_t const& rel : _cong._relations) {
+      RWS::word_to_rws_word(rel.first, &u);
+      RWS::word_to_rws_word(rel.second, &v);
+      rws.rewrite(&u);
+      rws.rewrite(&v);
+      if (u != v) {
+        word_t* lhs = RWS::rws_word_to_word(&u);
+        word_t* rhs = RWS::rws_word_to_word(&v);
+        _relations.emplace_back(std::move(*lhs), std::move(*rhs));
+        delete lhs;
+        delete rhs;
+      }
+    }
+    REPORT("using " << nr_rules << " rules and "
+                    << _relations.size() - nr_rules << " relations");
+  }
+}  // namespace libsemigroups
@@ -0,0 +1,42 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2017 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration for the private inner class of Congruence
+// called KBTC, which is a subclass of Congruence::TC.  This class is for
+// performing Knuth-Bendix, for a bounded number of rules, followed by the
+// Todd-Coxeter algorithm.
+
+#ifndef LIBSEMIGROUPS_SRC_CONG_KBTC_H_
+#define LIBSEMIGROUPS_SRC_CONG_KBTC_H_
+
+#include "../cong.h"
+#include "tc.h"
+
+namespace libsemigroups {
+
+  // Knuth-Bendix followed by Todd-Coxeter
+  class Congruence::KBTC : public Congruence::TC {
+   public:
+    explicit KBTC(Congruence& cong) : TC(cong) {}
+
+   private:
+    void add_cong_relations() final;
+  };
+}  // namespace libsemigroups
+
+#endif  // LIBSEMIGROUPS_SRC_CONG_KBTC_H_
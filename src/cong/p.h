@@ -22,6 +22,12 @@
 // congruence. It is intended that this runs before the underlying semigroup is
 // fully enumerated, and when the congruence contains a very small number of
 // related pairs.
+//
+// If the underlying semigroup is already fully enumerated when a P object is
+// constructed, then no elements are multiplied, copied, or hashed at all.
+// Instead pairs of positions in the semigroup are enumerated using its left
+// and right Cayley graphs, and the classes are stored in a UF over all the
+// positions.
 
 #ifndef LIBSEMIGROUPS_SRC_CONG_P_H_
 #define LIBSEMIGROUPS_SRC_CONG_P_H_
@@ -45,16 +51,28 @@ namespace libsemigroups {
             _class_lookup(),
             _done(false),
             _found_pairs(),
-            _lookup(0),
+            _ind_nr_pairs(0),
+            _ind_pairs_to_mult(),
+            _lookup(cong._semigroup->is_done() ? cong._semigroup->size() : 0),
             _map(),
             _map_next(0),
             _next_class(0),
             _pairs_to_mult(),
             _reverse_map(),
             _tmp1(),
-            _tmp2() {
+            _tmp2(),
+            _use_indices(cong._semigroup->is_done()) {
         LIBSEMIGROUPS_ASSERT(cong._semigroup != nullptr);
 
+        if (_use_indices) {
+          // Set up _ind_pairs_to_mult
+          for (relation_t const& rel : cong._extra) {
+            ind_add_pair(cong._semigroup->word_to_pos(rel.first),
+                         cong._semigroup->word_to_pos(rel.second));
+          }
+          return;
+        }
+
         auto semigroup = static_cast<Semigroup<TElementType>*>(cong._semigroup);
         _tmp1 = this->copy(semigroup->gens(0));
         _tmp2 = this->copy(_tmp1);
@@ -76,12 +94,16 @@ namespace libsemigroups {
             .swap(_found_pairs);
         std::queue<std::pair<TElementType, TElementType>>().swap(
             _pairs_to_mult);
+        std::queue<std::pair<element_index_t, element_index_t>>().swap(
+            _ind_pairs_to_mult);
       }
 
       ~P() {
         delete_tmp_storage();
-        this->free(_tmp1);
-        this->free(_tmp2);
+        if (!_use_indices) {
+          this->free(_tmp1);
+          this->free(_tmp2);
+        }
         for (auto& x : _map) {
           this->free(x.first);
         }
@@ -99,6 +121,9 @@ namespace libsemigroups {
 
       class_index_t word_to_class_index(word_t const& w) final {
         LIBSEMIGROUPS_ASSERT(is_done());
+        if (_use_indices) {
+          return _class_lookup[_cong._semigroup->word_to_pos(w)];
+        }
         auto semigroup
             = static_cast<Semigroup<TElementType>*>(_cong._semigroup);
         TElementType x     = semigroup->word_to_element(w);
@@ -114,6 +139,12 @@ namespace libsemigroups {
           return word_to_class_index(w1) == word_to_class_index(w2) ? TRUE
                                                                     : FALSE;
         }
+        if (_use_indices) {
+          return _lookup.find(_cong._semigroup->word_to_pos(w1))
+                         == _lookup.find(_cong._semigroup->word_to_pos(w2))
+                     ? TRUE
+                     : UNKNOWN;
+        }
         auto semigroup
             = static_cast<Semigroup<TElementType>*>(_cong._semigroup);
         TElementType x     = semigroup->word_to_element(w1);
@@ -127,6 +158,9 @@ namespace libsemigroups {
 
       Partition<word_t>* nontrivial_classes() final {
         LIBSEMIGROUPS_ASSERT(is_done());
+        if (_use_indices) {
+          return ind_nontrivial_classes();
+        }
         LIBSEMIGROUPS_ASSERT(_reverse_map.size() >= _nr_nontrivial_elms);
         LIBSEMIGROUPS_ASSERT(_class_lookup.size() >= _nr_nontrivial_elms);
 
@@ -157,6 +191,10 @@ namespace libsemigroups {
 
       void run(size_t steps, std::atomic<bool>& killed) {
         REPORT("number of steps = " << steps);
+        if (_use_indices) {
+          ind_run(steps, killed);
+          return;
+        }
         size_t tid = glob_reporter.thread_id(std::this_thread::get_id());
         while (!_pairs_to_mult.empty()) {
           // Get the next pair
@@ -210,6 +248,8 @@ namespace libsemigroups {
         }
         // Make a normalised class lookup (class numbers {0, .., n-1}, in order)
         if (_lookup.get_size() > 0) {
+          // After flattening, every find below is a single lookup.
+          _lookup.flatten();
           _class_lookup.reserve(_lookup.get_size());
           _next_class = 1;
           size_t nr;
@@ -245,6 +285,111 @@ namespace libsemigroups {
       }
 
      private:
+      typedef SemigroupBase::element_index_t element_index_t;
+
+      // This is the version of run used when the semigroup was fully
+      // enumerated before this was constructed.  Since a pair is only put on
+      // the queue when it merges two classes of _lookup, at most size - 1
+      // pairs are ever queued, and there is no need to remember which pairs
+      // have already been found.
+      void ind_run(size_t steps, std::atomic<bool>& killed) {
+        SemigroupBase* semigroup = _cong._semigroup;
+        bool left  = (_cong._type == LEFT || _cong._type == TWOSIDED);
+        bool right = (_cong._type == RIGHT || _cong._type == TWOSIDED);
+
+        while (!_ind_pairs_to_mult.empty()) {
+          std::pair<element_index_t, element_index_t> current_pair
+              = _ind_pairs_to_mult.front();
+          _ind_pairs_to_mult.pop();
+
+          for (size_t i = 0; i < _cong._nrgens; i++) {
+            if (left) {
+              ind_add_pair(semigroup->left(current_pair.first, i),
+                           semigroup->left(current_pair.second, i));
+            }
+            if (right) {
+              ind_add_pair(semigroup->right(current_pair.first, i),
+                           semigroup->right(current_pair.second, i));
+            }
+          }
+          if (this->_report_next++ > this->_report_interval) {
+            REPORT("found " << _ind_nr_pairs << " pairs, "
+                            << _ind_pairs_to_mult.size()
+                            << " pairs on the stack");
+            this->_report_next = 0;
+          }
+          if (killed) {
+            REPORT("killed");
+            return;
+          }
+          if (--steps == 0) {
+            return;
+          }
+        }
+
+        // Make a normalised class lookup (class numbers {0, .., n-1}, in order)
+        _class_lookup.clear();
+        _next_class = 0;
+        if (_lookup.get_size() > 0) {
+          // After flattening, every find below is a single lookup.
+          _lookup.flatten();
+          _class_lookup.reserve(_lookup.get_size());
+          _next_class = 1;
+          size_t nr;
+          size_t max = 0;
+          LIBSEMIGROUPS_ASSERT(_lookup.find(0) == 0);
+          _class_lookup.push_back(0);
+          for (size_t i = 1; i < _lookup.get_size(); i++) {
+            nr = _lookup.find(i);
+            if (nr > max) {
+              _class_lookup.push_back(_next_class++);
+              max = nr;
+            } else {
+              _class_lookup.push_back(_class_lookup[nr]);
+            }
+          }
+        }
+        REPORT("finished with " << _ind_nr_pairs << " pairs in " << _next_class
+                                << " classes");
+        _done = true;
+        delete_tmp_storage();
+      }
+
+      // The positions i and j are in the same class of _lookup if and only if
+      // (i, j) is a consequence of the pairs already found, and so we only
+      // have to consider (i, j) further if it is not.
+      void ind_add_pair(element_index_t i, element_index_t j) {
+        LIBSEMIGROUPS_ASSERT(_use_indices);
+        if (_lookup.find(i) != _lookup.find(j)) {
+          _lookup.unite(i, j);
+          _ind_pairs_to_mult.push(std::make_pair(i, j));
+          _ind_nr_pairs++;
+        }
+      }
+
+      Partition<word_t>* ind_nontrivial_classes() {
+        LIBSEMIGROUPS_ASSERT(_class_lookup.size() == _lookup.get_size());
+        std::vector<size_t> sizes(_next_class, 0);
+        for (class_index_t const& c : _class_lookup) {
+          sizes[c]++;
+        }
+        std::vector<class_index_t> part_lookup(_next_class, UNDEFINED);
+        size_t                     nr_parts = 0;
+        for (class_index_t c = 0; c < _next_class; c++) {
+          if (sizes[c] > 1) {
+            part_lookup[c] = nr_parts++;
+          }
+        }
+        Partition<word_t>* classes = new Partition<word_t>(nr_parts);
+        for (size_t pos = 0; pos < _class_lookup.size(); pos++) {
+          class_index_t part = part_lookup[_class_lookup[pos]];
+          if (part != UNDEFINED) {
+            (*classes)[part]->push_back(_cong._semigroup->factorisation(pos));
+          }
+        }
+        return classes;
+      }
+
       struct PHash {
        public:
         size_t
@@ -331,6 +476,9 @@ namespace libsemigroups {
       bool                       _done;
       std::unordered_set<std::pair<TElementType, TElementType>, PHash, PEqual>
           _found_pairs;
+      size_t _ind_nr_pairs;
+      std::queue<std::pair<element_index_t, element_index_t>>
+          _ind_pairs_to_mult;
       UF  _lookup;
       std::unordered_map<TElementType, size_t> _map;
       size_t        _map_next;
@@ -341,6 +489,7 @@ namespace libsemigroups {
       std::vector<TElementType> _reverse_map;
       TElementType              _tmp1;
       TElementType              _tmp2;
+      bool                      _use_indices;
     };
 }  // namespace libsemigroups
 #endif  // LIBSEMIGROUPS_SRC_CONG_P_H_
@@ -196,14 +196,8 @@ namespace libsemigroups {
       return;
     }
 
-    // Initialise the relations in the enclosing Congruence object. We do not
-    // call relations() here so that we can pass _killed.
+    add_cong_relations();
 
-    _cong.init_relations(_cong._semigroup, _killed);
-
-    // Must insert at _relations.end() since it might be non-empty
-    _relations.insert(
-        _relations.end(), _cong._relations.begin(), _cong._relations.end());
     // FIXME avoid copying in the RIGHT case
     switch (_cong._type) {
       case RIGHT:
@@ -221,6 +215,17 @@ namespace libsemigroups {
     }
   }
 
+  void Congruence::TC::add_cong_relations() {
+    // Initialise the relations in the enclosing Congruence object. We do not
+    // call relations() here so that we can pass _killed.
+
+    _cong.init_relations(_cong._semigroup, _killed);
+
+    // Must insert at _relations.end() since it might be non-empty
+    _relations.insert(
+        _relations.end(), _cong._relations.begin(), _cong._relations.end());
+  }
+
   // compress the table
   void Congruence::TC::compress() {
     LIBSEMIGROUPS_ASSERT(is_done());
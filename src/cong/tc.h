@@ -31,6 +31,7 @@
 namespace libsemigroups {
 
   class Congruence::TC : public Congruence::DATA {
+    friend KBTC;
     typedef int64_t signed_class_index_t;
 
    public:
@@ -67,6 +68,10 @@ namespace libsemigroups {
     void init_after_prefill();
     void init_tc_relations();
 
+    // This method appends the relations of the enclosing Congruence to
+    // _relations, it is overridden by KBTC.
+    virtual void add_cong_relations();
+
     void        new_coset(class_index_t const&, letter_t const&);
     void        identify_cosets(class_index_t, class_index_t);
     inline void trace(class_index_t const&, relation_t const&, bool add = true);
@@ -0,0 +1,257 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2017 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "conglattice.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "report.h"
+#include "timer.h"
+
+namespace libsemigroups {
+
+  CongruenceLattice::CongruenceLattice(std::string    type,
+                                       SemigroupBase* semigroup)
+      : _congs(),
+        _graphs(),
+        _map(),
+        _max_threads(std::thread::hardware_concurrency()),
+        _nr_principal(0),
+        _principal(),
+        _principal_done(false),
+        _semigroup(semigroup) {
+    LIBSEMIGROUPS_ASSERT(type == "left" || type == "right"
+                         || type == "twosided");
+    if (type == "left" || type == "twosided") {
+      _graphs.push_back(semigroup->left_cayley_graph_copy());
+    }
+    if (type == "right" || type == "twosided") {
+      _graphs.push_back(semigroup->right_cayley_graph_copy());
+    }
+    // The trivial congruence has index 0
+    UF::table_t trivial;
+    trivial.reserve(semigroup->size());
+    for (size_t i = 0; i < semigroup->size(); i++) {
+      trivial.push_back(i);
+    }
+    add_congruence(trivial);
+  }
+
+  CongruenceLattice::~CongruenceLattice() {
+    for (SemigroupBase::cayley_graph_t* graph : _graphs) {
+      delete graph;
+    }
+  }
+
+  void CongruenceLattice::set_max_threads(size_t nr_threads) {
+    unsigned int n
+        = static_cast<unsigned int>(nr_threads == 0 ? 1 : nr_threads);
+    _max_threads
+        = std::max(1U, std::min(n, std::thread::hardware_concurrency()));
+  }
+
+  void CongruenceLattice::set_report(bool val) const {
+    glob_reporter.set_report(val);
+  }
+
+  size_t CongruenceLattice::hash(UF::table_t const& table) {
+    size_t seed = 0;
+    for (auto const& x : table) {
+      seed ^= std::hash<size_t>{}(x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+
+  CongruenceLattice::cong_index_t
+  CongruenceLattice::add_congruence(UF::table_t const& table) {
+    size_t h     = hash(table);
+    auto   range = _map.equal_range(h);
+    for (auto it = range.first; it != range.second; it++) {
+      if (_congs[it->second] == table) {
+        return it->second;
+      }
+    }
+    _map.emplace(h, _congs.size());
+    _congs.push_back(table);
+    return _congs.size() - 1;
+  }
+
+  void CongruenceLattice::principal_table(RollbackUF&          uf,
+                                          std::vector<pair_t>& stack,
+                                          element_index_t      i,
+                                          element_index_t      j,
+                                          UF::table_t&         table) const {
+    LIBSEMIGROUPS_ASSERT(stack.empty());
+    size_t const nrgens = _semigroup->nrgens();
+    uf.checkpoint();
+    if (uf.unite(i, j)) {
+      stack.push_back(std::make_pair(i, j));
+    }
+    while (!stack.empty()) {
+      pair_t current_pair = stack.back();
+      stack.pop_back();
+      for (SemigroupBase::cayley_graph_t const* graph : _graphs) {
+        for (size_t a = 0; a < nrgens; a++) {
+          element_index_t x = graph->get(current_pair.first, a);
+          element_index_t y = graph->get(current_pair.second, a);
+          if (uf.unite(x, y)) {
+            stack.push_back(std::make_pair(x, y));
+          }
+        }
+      }
+    }
+    table = uf.get_table();
+    uf.rollback();
+  }
+
+  // The pair (i, j) with i < j is stored in position j * (j - 1) / 2 + i of
+  // <_principal>.
+  void CongruenceLattice::init_principal() {
+    if (_principal_done) {
+      return;
+    }
+    Timer        timer;
+    size_t const n = _semigroup->size();
+    _principal.resize(n < 2 ? 0 : n * (n - 1) / 2, 0);
+
+    size_t nr_threads = std::max(size_t(1), std::min(n, _max_threads));
+    REPORT("using " << nr_threads << " / "
+                    << std::thread::hardware_concurrency() << " threads");
+
+    // Every thread deduplicates its own congruences, which are then merged
+    // serially.
+    std::vector<std::vector<UF::table_t>> congs(nr_threads);
+    std::vector<std::vector<cong_index_t>> lookup(nr_threads);
+
+    auto go = [this, n, nr_threads, &congs, &lookup](size_t tid) {
+      RollbackUF                                    uf(n);
+      std::vector<pair_t>                           stack;
+      std::unordered_multimap<size_t, cong_index_t> map;
+      UF::table_t                                   table;
+      for (size_t j = tid + 1; j < n; j += nr_threads) {
+        for (size_t i = 0; i < j; i++) {
+          principal_table(uf, stack, i, j, table);
+          size_t       h     = hash(table);
+          auto         range = map.equal_range(h);
+          cong_index_t index = congs[tid].size();
+          for (auto it = range.first; it != range.second; it++) {
+            if (congs[tid][it->second] == table) {
+              index = it->second;
+              break;
+            }
+          }
+          if (index == congs[tid].size()) {
+            map.emplace(h, index);
+            congs[tid].push_back(table);
+          }
+          lookup[tid].push_back(index);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t tid = 0; tid < nr_threads; tid++) {
+      threads.push_back(std::thread(go, tid));
+    }
+    for (size_t tid = 0; tid < nr_threads; tid++) {
+      threads[tid].join();
+    }
+
+    for (size_t tid = 0; tid < nr_threads; tid++) {
+      std::vector<cong_index_t> global;
+      global.reserve(congs[tid].size());
+      for (UF::table_t const& table : congs[tid]) {
+        global.push_back(add_congruence(table));
+      }
+      std::vector<UF::table_t>().swap(congs[tid]);
+      size_t k = 0;
+      for (size_t j = tid + 1; j < n; j += nr_threads) {
+        for (size_t i = 0; i < j; i++) {
+          _principal[j * (j - 1) / 2 + i] = global[lookup[tid][k++]];
+        }
+      }
+    }
+    _nr_principal   = _congs.size() - 1;
+    _principal_done = true;
+    REPORT("found " << _nr_principal << " principal congruences in "
+                    << timer);
+  }
+
+  CongruenceLattice::cong_index_t
+  CongruenceLattice::principal_congruence(element_index_t i,
+                                          element_index_t j) {
+    LIBSEMIGROUPS_ASSERT(i < _semigroup->size() && j < _semigroup->size());
+    if (i == j) {
+      return 0;
+    } else if (i > j) {
+      std::swap(i, j);
+    }
+    init_principal();
+    return _principal[j * (j - 1) / 2 + i];
+  }
+
+  size_t CongruenceLattice::nr_congruences() {
+    init_principal();
+    // Every congruence is the join of a congruence already found, and a
+    // principal congruence.
+    for (cong_index_t i = 1; i < _congs.size(); i++) {
+      for (cong_index_t j = 1; j <= _nr_principal; j++) {
+        join(i, j);
+      }
+    }
+    return _congs.size();
+  }
+
+  size_t CongruenceLattice::nr_classes(cong_index_t i) const {
+    UF::table_t const& table = _congs.at(i);
+    size_t             count = 0;
+    for (size_t k = 0; k < table.size(); k++) {
+      if (table[k] == k) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  bool CongruenceLattice::is_contained(cong_index_t i, cong_index_t j) const {
+    UF::table_t const& tablei = _congs.at(i);
+    UF::table_t const& tablej = _congs.at(j);
+    for (size_t k = 0; k < tablei.size(); k++) {
+      if (tablej[tablei[k]] != tablej[k]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  CongruenceLattice::cong_index_t CongruenceLattice::join(cong_index_t i,
+                                                          cong_index_t j) {
+    if (is_contained(i, j)) {
+      return j;
+    } else if (is_contained(j, i)) {
+      return i;
+    }
+    UF uf(_congs[i]);
+    for (size_t k = 0; k < uf.get_size(); k++) {
+      uf.unite(k, _congs[j][k]);
+    }
+    uf.flatten();
+    return add_congruence(*uf.get_table());
+  }
+}  // namespace libsemigroups
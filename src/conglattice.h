@@ -0,0 +1,162 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2017 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of the class CongruenceLattice, which can
+// be used to compute the principal congruences, and the lattice of
+// congruences, of a finite semigroup.
+
+#ifndef LIBSEMIGROUPS_SRC_CONGLATTICE_H_
+#define LIBSEMIGROUPS_SRC_CONGLATTICE_H_
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "semigroups-base.h"
+#include "uf.h"
+
+namespace libsemigroups {
+  //! Class for computing the lattice of (left, right, or two-sided)
+  //! congruences of a finite Semigroup.
+  //!
+  //! Every congruence is represented by a libsemigroups::UF::table_t, which
+  //! has length equal to the size of the semigroup, and whose entry in
+  //! position \c i is the least position of an element in the same class as
+  //! the element in position \c i. Two congruences are equal if and only if
+  //! their tables are equal. Every congruence found is given an index, the
+  //! trivial congruence has index \c 0.
+  //!
+  //! The principal congruences are computed, in parallel, using only the
+  //! left or right Cayley graphs of the semigroup, and without multiplying any
+  //! elements of the semigroup. Since every congruence is a join of principal
+  //! congruences, and the join of two congruences is their join as equivalence
+  //! relations, the remaining congruences are computed by merging the tables
+  //! of the principal congruences.
+  class CongruenceLattice {
+   public:
+    //! Type for the position of an element in a Semigroup.
+    typedef SemigroupBase::element_index_t element_index_t;
+
+    //! Type for the index of a congruence in a CongruenceLattice.
+    typedef size_t cong_index_t;
+
+    //! Constructs a CongruenceLattice for the congruences of type \p type of
+    //! \p semigroup.
+    //!
+    //! The parameter \p type must be one of \c "left", \c "right", or \c
+    //! "twosided". It is the responsibility of the caller to delete \p
+    //! semigroup, which is fully enumerated by this constructor.
+    CongruenceLattice(std::string type, SemigroupBase* semigroup);
+
+    //! A default destructor.
+    ~CongruenceLattice();
+
+    //! The copy constructor is deleted for CongruenceLattice to avoid
+    //! unintended copying.
+    CongruenceLattice(CongruenceLattice const& copy) = delete;
+
+    //! The assignment operator is deleted for CongruenceLattice to avoid
+    //! unintended copying.
+    CongruenceLattice& operator=(CongruenceLattice const& copy) = delete;
+
+    //! Set the maximum number of threads used to compute the principal
+    //! congruences.
+    //!
+    //! The number of threads is limited to the maximum of 1 and the minimum
+    //! of \p nr_threads and the number of threads supported by the hardware.
+    void set_max_threads(size_t nr_threads);
+
+    //! Returns the number of distinct non-trivial principal congruences.
+    //!
+    //! The non-trivial principal congruences have indices \c 1 to \c
+    //! CongruenceLattice::nr_principal_congruences (inclusive).
+    size_t nr_principal_congruences() {
+      init_principal();
+      return _nr_principal;
+    }
+
+    //! Returns the index of the congruence generated by the pair of elements
+    //! in positions \p i and \p j of the semigroup.
+    cong_index_t principal_congruence(element_index_t i, element_index_t j);
+
+    //! Returns the number of congruences found so far.
+    //!
+    //! If CongruenceLattice::nr_congruences has been called, then this is the
+    //! number of congruences.
+    size_t current_nr_congruences() const {
+      return _congs.size();
+    }
+
+    //! Returns the number of congruences of the semigroup.
+    //!
+    //! This method computes every congruence of the semigroup, i.e. all joins
+    //! of the principal congruences, and its number of congruences may be
+    //! very large.
+    size_t nr_congruences();
+
+    //! Returns the table of the congruence with index \p i, see the
+    //! description of CongruenceLattice for more details.
+    UF::table_t const& congruence(cong_index_t i) const {
+      return _congs.at(i);
+    }
+
+    //! Returns the number of classes of the congruence with index \p i.
+    size_t nr_classes(cong_index_t i) const;
+
+    //! Returns the index of the join of the congruences with indices \p i
+    //! and \p j.
+    cong_index_t join(cong_index_t i, cong_index_t j);
+
+    //! Returns \c true if the congruence with index \p i is contained in the
+    //! congruence with index \p j.
+    bool is_contained(cong_index_t i, cong_index_t j) const;
+
+    //! Turn reporting on or off.
+    void set_report(bool val) const;
+
+   private:
+    typedef std::pair<element_index_t, element_index_t> pair_t;
+
+    static size_t hash(UF::table_t const& table);
+
+    // Returns the index of the congruence with the table <table>, adding it if
+    // it is not already in <_congs>.
+    cong_index_t add_congruence(UF::table_t const& table);
+
+    void init_principal();
+
+    // Computes the table of the congruence generated by (i, j) using <uf>,
+    // which is returned to its original state.
+    void principal_table(RollbackUF&          uf,
+                         std::vector<pair_t>& stack,
+                         element_index_t      i,
+                         element_index_t      j,
+                         UF::table_t&         table) const;
+
+    std::vector<UF::table_t>                      _congs;
+    std::vector<SemigroupBase::cayley_graph_t*>   _graphs;
+    std::unordered_multimap<size_t, cong_index_t> _map;
+    size_t                                        _max_threads;
+    size_t                                        _nr_principal;
+    std::vector<cong_index_t>                     _principal;
+    bool                                          _principal_done;
+    SemigroupBase*                                _semigroup;
+  };
+}  // namespace libsemigroups
+#endif  // LIBSEMIGROUPS_SRC_CONGLATTICE_H_
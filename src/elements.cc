@@ -449,4 +449,138 @@ namespace libsemigroups {
       }
     }
   }
+
+  // Partitioned binary relations stored as bitsets (BitPBRs)
+  std::vector<std::vector<u_int64_t>>
+      BitPBR::_tmp(std::thread::hardware_concurrency());
+
+  // Returns the bits of the word t of a row which correspond to the points
+  // 0, ..., n - 1.
+  static inline u_int64_t low_mask(size_t const& t, size_t const& n) {
+    if (n >= 64 * (t + 1)) {
+      return ~static_cast<u_int64_t>(0);
+    } else if (n <= 64 * t) {
+      return 0;
+    }
+    return (static_cast<u_int64_t>(1) << (n - 64 * t)) - 1;
+  }
+
+  BitPBR::BitPBR(std::vector<std::vector<u_int32_t>> const& adj)
+      : ElementWithVectorDataDefaultHash<u_int64_t, BitPBR>(
+            new std::vector<u_int64_t>(adj.size() * nr_words(adj.size()),
+                                       0)) {
+    LIBSEMIGROUPS_ASSERT(adj.size() % 2 == 0);
+    size_t const W = nr_words(adj.size());
+    for (size_t i = 0; i < adj.size(); i++) {
+      for (u_int32_t const& j : adj[i]) {
+        LIBSEMIGROUPS_ASSERT(j < adj.size());
+        (*_vector)[i * W + j / 64] |= static_cast<u_int64_t>(1) << (j % 64);
+      }
+    }
+  }
+
+  size_t BitPBR::complexity() const {
+    size_t const n = this->degree();
+    return 8 * n * n * nr_words(2 * n);
+  }
+
+  size_t BitPBR::degree() const {
+    // _vector has 2n * nr_words(2n) entries where n is the degree, and so we
+    // find the number of words per row W by trying every W which is not too
+    // large.
+    size_t const s = _vector->size();
+    for (size_t W = 1; 64 * (W - 1) * W <= s; W++) {
+      if (s % W == 0 && nr_words(s / W) == W) {
+        return s / (2 * W);
+      }
+    }
+    return 0;
+  }
+
+  Element* BitPBR::identity() const {
+    size_t const           n = this->degree();
+    size_t const           W = nr_words(2 * n);
+    std::vector<u_int64_t>* adj(new std::vector<u_int64_t>(2 * n * W, 0));
+    for (size_t i = 0; i < n; i++) {
+      (*adj)[i * W + (i + n) / 64] |= static_cast<u_int64_t>(1)
+                                      << ((i + n) % 64);
+      (*adj)[(i + n) * W + i / 64] |= static_cast<u_int64_t>(1) << (i % 64);
+    }
+    return new BitPBR(adj);
+  }
+
+  void BitPBR::redefine(Element const* xx,
+                        Element const* yy,
+                        size_t const&  thread_id) {
+    LIBSEMIGROUPS_ASSERT(xx->degree() == yy->degree());
+    LIBSEMIGROUPS_ASSERT(xx->degree() == this->degree());
+    LIBSEMIGROUPS_ASSERT(xx != this && yy != this);
+
+    u_int64_t const* x = static_cast<BitPBR const*>(xx)->_vector->data();
+    u_int64_t const* y = static_cast<BitPBR const*>(yy)->_vector->data();
+
+    size_t const n = this->degree();
+    size_t const W = nr_words(2 * n);
+
+    // In the product, the points n, ..., 2n - 1 of x are identified with the
+    // points 0, ..., n - 1 of y. A path in the product alternates between x
+    // and y, and so we consider the graph where the point m + n of x is the
+    // vertex m, and the point m of y is the vertex m + n. With this
+    // numbering, if m + n is adjacent to j in x and j >= n, then the path
+    // continues from the point j - n of y, which is the vertex j, and
+    // similarly for y. So the rows of x and y can be used as they are.
+    //
+    // The row m of tmp consists of W words for the vertices adjacent to m,
+    // followed by W words for the points of the product adjacent to m.
+    std::vector<u_int64_t>& tmp = _tmp[thread_id];
+    tmp.resize(4 * n * W);
+
+    for (size_t m = 0; m < 2 * n; m++) {
+      u_int64_t const* row = (m < n ? x + (m + n) * W : y + (m - n) * W);
+      u_int64_t*       adj = tmp.data() + 2 * m * W;
+      for (size_t t = 0; t < W; t++) {
+        u_int64_t const low = low_mask(t, n);
+        if (m < n) {
+          adj[t]     = row[t] & ~low;
+          adj[t + W] = row[t] & low;
+        } else {
+          adj[t]     = row[t] & low;
+          adj[t + W] = row[t] & ~low;
+        }
+      }
+    }
+
+    // Warshall's algorithm: after the k-th step, the first half of row i is
+    // the set of vertices reachable from i via vertices less than k, and the
+    // second half is the set of points of the product adjacent to any of them.
+    for (size_t k = 0; k < 2 * n; k++) {
+      u_int64_t const* row_k = tmp.data() + 2 * k * W;
+      for (size_t i = 0; i < 2 * n; i++) {
+        u_int64_t* row_i = tmp.data() + 2 * i * W;
+        if ((row_i[k / 64] >> (k % 64)) & 1) {
+          for (size_t t = 0; t < 2 * W; t++) {
+            row_i[t] |= row_k[t];
+          }
+        }
+      }
+    }
+
+    for (size_t i = 0; i < 2 * n; i++) {
+      u_int64_t const* row = (i < n ? x : y) + i * W;
+      u_int64_t*       out = _vector->data() + i * W;
+      for (size_t t = 0; t < W; t++) {
+        out[t] = row[t] & (i < n ? low_mask(t, n) : ~low_mask(t, n));
+      }
+      size_t const first = (i < n ? n : 0);
+      for (size_t j = first; j < first + n; j++) {
+        if ((row[j / 64] >> (j % 64)) & 1) {
+          u_int64_t const* reached = tmp.data() + (2 * j + 1) * W;
+          for (size_t t = 0; t < W; t++) {
+            out[t] |= reached[t];
+          }
+        }
+      }
+    }
+    this->reset_hash_value();
+  }
 }  // namespace libsemigroups
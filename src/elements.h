@@ -26,10 +26,12 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
 #include "blocks.h"
+#include "hash.h"
 #include "libsemigroups-debug.h"
 #include "recvec.h"
 #include "semiring.h"
@@ -128,6 +130,19 @@ namespace libsemigroups {
     //! \sa Element::really_delete.
     virtual Element* really_copy(size_t increase_deg_by = 0) const = 0;
 
+    //! Increases the degree of \c this by \p increase_deg_by in-place.
+    //!
+    //! This method changes \c this into the element that would be returned
+    //! by Element::really_copy with argument \p increase_deg_by, without
+    //! copying the defining data of \c this. Any subclass of Element whose
+    //! Element::really_copy supports a non-zero argument must override this
+    //! method, the implementation in the Element base class asserts that
+    //! \p increase_deg_by is 0.
+    virtual void increase_degree_by(size_t increase_deg_by) {
+      LIBSEMIGROUPS_ASSERT(increase_deg_by == 0);
+      (void) increase_deg_by;
+    }
+
     //! Copy another Element into \c this.
     //!
     //! This method copies \p x into \c this by changing \c this in-place.
@@ -409,8 +424,37 @@ namespace libsemigroups {
     // vectors, and there is not std::hash<vector<whatever>>.
     //! Returns a hash value for a vector provided there is a specialization of
     //! std::hash for the template type \p T.
+    //!
+    //! If \c LIBSEMIGROUPS_USE_MIXHASH is defined, which it is unless
+    //! libsemigroups is configured with \c --disable-mixhash, and \p T is an
+    //! integral type other than \c bool, then the data of \p vec is hashed
+    //! several entries at a time using hash_bytes. Otherwise the hash values
+    //! of the entries of \p vec are combined one at a time.
     template <typename T>
     static inline size_t vector_hash(std::vector<T> const* vec) {
+#ifdef LIBSEMIGROUPS_USE_MIXHASH
+      return vector_hash(vec,
+                         std::integral_constant<bool,
+                                                std::is_integral<T>::value
+                                                    && !std::is_same<T, bool>::
+                                                           value>());
+#else
+      return vector_hash(vec, std::false_type());
+#endif
+    }
+
+    //! Returns a hash value for a vector of integers using hash_bytes.
+    template <typename T>
+    static inline size_t vector_hash(std::vector<T> const* vec,
+                                     std::true_type) {
+      return hash_bytes(vec->data(), vec->size() * sizeof(T));
+    }
+
+    //! Returns a hash value for a vector by combining the hash values of its
+    //! entries one at a time.
+    template <typename T>
+    static inline size_t vector_hash(std::vector<T> const* vec,
+                                     std::false_type) {
       size_t seed = 0;
       for (auto const& x : *vec) {
         seed ^= std::hash<T>{}(x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
@@ -508,12 +552,11 @@ namespace libsemigroups {
     //! image values, not including PartialTransformation::UNDEFINED. This
     //! method recomputes the return value every time it is called.
     size_t crank() const {
-      _lookup.clear();
-      _lookup.resize(degree(), false);
-      size_t r = 0;
+      std::vector<bool> lookup(degree(), false);
+      size_t            r = 0;
       for (auto const& x : *(this->_vector)) {
-        if (x != UNDEFINED && !_lookup[x]) {
-          _lookup[x] = true;
+        if (x != UNDEFINED && !lookup[x]) {
+          lookup[x] = true;
           r++;
         }
       }
@@ -539,16 +582,8 @@ namespace libsemigroups {
     //! This value is used to indicate that a partial transformation is not
     //! defined on a value.
     static TValueType const UNDEFINED;
-
-   private:
-    // Used for determining rank
-    static std::vector<bool> _lookup;
   };
 
-  template <typename TValueType, typename TSubclass>
-  std::vector<bool> PartialTransformation<TValueType, TSubclass>::_lookup
-      = std::vector<bool>();
-
   template <typename TValueType, typename TSubclass>
   TValueType const PartialTransformation<TValueType, TSubclass>::UNDEFINED
       = std::numeric_limits<TValueType>::max();
@@ -578,16 +613,27 @@ namespace libsemigroups {
     Element* really_copy(size_t increase_deg_by = 0) const override {
       Transformation<T>* copy
           = new Transformation<T>(new std::vector<T>(*this->_vector));
+      copy->_hash_value = this->_hash_value;
+      copy->increase_degree_by(increase_deg_by);
+      return copy;
+    }
+
+    //! Increases the degree of \c this by \p increase_deg_by in-place.
+    //!
+    //! See Element::increase_degree_by for more details about this method.
+    //!
+    //! The values between the old and new Transformation::degree of \c this
+    //! are fixed.
+    void increase_degree_by(size_t increase_deg_by) override {
       if (increase_deg_by == 0) {
-        copy->_hash_value = this->_hash_value;
-      } else {
-        size_t n = copy->_vector->size();
-        copy->_vector->reserve(n + increase_deg_by);
-        for (size_t i = n; i < n + increase_deg_by; i++) {
-          copy->_vector->push_back(i);
-        }
+        return;
       }
-      return copy;
+      size_t n = this->_vector->size();
+      this->_vector->reserve(n + increase_deg_by);
+      for (size_t i = n; i < n + increase_deg_by; i++) {
+        this->_vector->push_back(i);
+      }
+      this->reset_hash_value();
     }
 
     //! Multiply \p x and \p y and stores the result in \c this.
@@ -612,9 +658,22 @@ namespace libsemigroups {
    protected:
     //! This method is included because it seems to give superior performance
     //! in some benchmarks.
+    //!
+    //! The images of a transformation of degree \f$n\f$ are combined as the
+    //! digits of a number in base \f$n\f$, which is injective when
+    //! \f$n^n\f$ is at most \f$2 ^ {64}\f$, i.e. when \f$n \leq 16\f$.
+    //! For larger degrees, the leading images are lost to overflow, and so,
+    //! unless libsemigroups is configured with \c --disable-mixhash,
+    //! hash_bytes is used instead.
     void cache_hash_value() const override {
       size_t seed = 0;
       size_t deg  = this->_vector->size();
+#ifdef LIBSEMIGROUPS_USE_MIXHASH
+      if (deg > 16) {
+        this->_hash_value = hash_bytes(this->_vector->data(), deg * sizeof(T));
+        return;
+      }
+#endif
       for (auto const& val : *(this->_vector)) {
         seed *= deg;
         seed += val;
@@ -717,16 +776,27 @@ namespace libsemigroups {
     Element* really_copy(size_t increase_deg_by = 0) const override {
       PartialPerm<T>* copy
           = new PartialPerm<T>(new std::vector<T>(*this->_vector));
+      copy->_hash_value = this->_hash_value;
+      copy->increase_degree_by(increase_deg_by);
+      return copy;
+    }
+
+    //! Increases the degree of \c this by \p increase_deg_by in-place.
+    //!
+    //! See Element::increase_degree_by for more details about this method.
+    //!
+    //! \c this is undefined on all the values between the old and new
+    //! PartialPerm::degree of \c this.
+    void increase_degree_by(size_t increase_deg_by) override {
       if (increase_deg_by == 0) {
-        copy->_hash_value = this->_hash_value;
-      } else {
-        size_t n = copy->_vector->size();
-        copy->_vector->reserve(n + increase_deg_by);
-        for (size_t i = n; i < n + increase_deg_by; i++) {
-          copy->_vector->push_back(UNDEFINED);
-        }
+        return;
       }
-      return copy;
+      size_t n = this->_vector->size();
+      this->_vector->reserve(n + increase_deg_by);
+      for (size_t i = n; i < n + increase_deg_by; i++) {
+        this->_vector->push_back(UNDEFINED);
+      }
+      this->reset_hash_value();
     }
 
     //! Multiply \p x and \p y and stores the result in \c this.
@@ -1114,18 +1184,8 @@ namespace libsemigroups {
       // LIBSEMIGROUPS_ASSERT(xx->semiring() == yy->semiring() &&
       // xx->semiring() == this->semiring());
       // TODO verify that x, y, and this are defined over the same semiring.
-      size_t deg = this->degree();
-
-      for (size_t i = 0; i < deg; i++) {
-        for (size_t j = 0; j < deg; j++) {
-          int64_t v = _semiring->zero();
-          for (size_t k = 0; k < deg; k++) {
-            v = _semiring->plus(
-                v, _semiring->prod((*xx)[i * deg + k], (*yy)[k * deg + j]));
-          }
-          (*this->_vector)[i * deg + j] = v;
-        }
-      }
+      _semiring->matrix_product(
+          *xx->_vector, *yy->_vector, *this->_vector, this->degree());
       after();  // post process this
       this->reset_hash_value();
     }
@@ -1163,6 +1223,115 @@ namespace libsemigroups {
         MatrixOverSemiringBase;
   };
 
+  //! Matrices over a semiring known at compile time.
+  //!
+  //! This class is similar to MatrixOverSemiring, except that the semiring is
+  //! given by the template parameter \p TSemiring, rather than by a pointer to
+  //! a Semiring. The class \p TSemiring must have a type \c value_type, and
+  //! static member functions \c zero, \c one, \c plus, and \c prod, such as
+  //! StaticTropicalMaxPlusSemiring. Since these are known at compile time,
+  //! they can be inlined in the inner loop of
+  //! StaticMatrixOverSemiring::redefine.
+  template <class TSemiring>
+  class StaticMatrixOverSemiring
+      : public ElementWithVectorDataDefaultHash<
+            typename TSemiring::value_type,
+            StaticMatrixOverSemiring<TSemiring>> {
+    using value_type = typename TSemiring::value_type;
+
+   public:
+    //! A constructor.
+    //!
+    //! Constructs a matrix defined by \p matrix, \p matrix is not copied,
+    //! and should be deleted using ElementWithVectorData::really_delete.
+    //!
+    //! The parameter \p matrix should be a vector of values of length
+    //! \f$n ^ 2\f$ for some integer \f$n\f$, so that the value in position
+    //! \f$in + j\f$ is the entry in the \f$i\f$th row and \f$j\f$th column of
+    //! the constructed matrix.
+    explicit StaticMatrixOverSemiring(std::vector<value_type>* matrix)
+        : ElementWithVectorDataDefaultHash<value_type,
+                                           StaticMatrixOverSemiring>(matrix),
+          _degree(sqrt(matrix->size())) {
+      LIBSEMIGROUPS_ASSERT(matrix->size() == _degree * _degree);
+    }
+
+    //! A constructor.
+    //!
+    //! Constructs a matrix whose rows are the vectors in \p matrix, which is
+    //! copied into the constructed object. This method asserts that \p
+    //! matrix is not empty, and that every vector contained in \p matrix has
+    //! the same length as \p matrix.
+    explicit StaticMatrixOverSemiring(
+        std::vector<std::vector<value_type>> const& matrix)
+        : ElementWithVectorDataDefaultHash<value_type,
+                                           StaticMatrixOverSemiring>(),
+          _degree(matrix.size()) {
+      LIBSEMIGROUPS_ASSERT(!matrix.empty());
+      LIBSEMIGROUPS_ASSERT(all_of(
+          matrix.begin(), matrix.end(), [&matrix](std::vector<value_type> row) {
+            return row.size() == matrix.size();
+          }));
+      this->_vector->reserve(matrix.size() * matrix.size());
+      for (auto const& row : matrix) {
+        this->_vector->insert(this->_vector->end(), row.begin(), row.end());
+      }
+    }
+
+    //! Returns the approximate time complexity of multiplying two matrices.
+    //!
+    //! The approximate time complexity of multiplying matrices is \f$n ^ 3\f$
+    //! where \f$n\f$ is the dimension of the matrix.
+    size_t complexity() const override {
+      return pow(_degree, 3);
+    }
+
+    //! Returns the dimension of the matrix.
+    size_t degree() const override {
+      return _degree;
+    }
+
+    //! Returns the identity matrix with dimension of \c this.
+    //!
+    //! This method returns a new matrix with dimension equal to that of \c
+    //! this, where the main diagonal consists of the value \c TSemiring::one
+    //! and every other entry \c TSemiring::zero.
+    Element* identity() const override {
+      std::vector<value_type>* vec(
+          new std::vector<value_type>(_degree * _degree, TSemiring::zero()));
+      for (size_t i = 0; i < _degree; i++) {
+        (*vec)[i * _degree + i] = TSemiring::one();
+      }
+      return new StaticMatrixOverSemiring(vec);
+    }
+
+    //! Multiply \p x and \p y and stores the result in \c this.
+    //!
+    //! This method asserts that the degrees of \p x, \p y, and \c this, are
+    //! all equal, and that neither \p x nor \p y equals \c this.
+    //!
+    //! The entries of the product are accumulated a row at a time, so that
+    //! the innermost loop runs over contiguous entries of \p y and \c this,
+    //! and can be vectorised by the compiler.
+    void redefine(Element const* x, Element const* y) override {
+      LIBSEMIGROUPS_ASSERT(x->degree() == y->degree());
+      LIBSEMIGROUPS_ASSERT(x->degree() == this->degree());
+      LIBSEMIGROUPS_ASSERT(x != this && y != this);
+      matrix_product(
+          *static_cast<StaticMatrixOverSemiring const*>(x)->_vector,
+          *static_cast<StaticMatrixOverSemiring const*>(y)->_vector,
+          *this->_vector,
+          _degree,
+          TSemiring::zero(),
+          [](value_type a, value_type b) { return TSemiring::plus(a, b); },
+          [](value_type a, value_type b) { return TSemiring::prod(a, b); });
+      this->reset_hash_value();
+    }
+
+   private:
+    size_t _degree;
+  };
+
   //! Class for projective max-plus matrices.
   //!
   //! These matrices belong to the quotient of the monoid of all max-plus
@@ -1391,6 +1560,76 @@ namespace libsemigroups {
     static std::vector<RecVec<bool>>      _tmp;
   };
 
+  //! Class for partitioned binary relations (PBR) stored as bitsets.
+  //!
+  //! This class represents the same objects as PBR, but the points adjacent
+  //! to every point are stored as a row of bits packed into 64-bit words.
+  //! Products are found by computing a transitive closure using Warshall's
+  //! algorithm on whole words at a time, rather than by depth first search,
+  //! and hashing and comparison only have to look at the packed words.
+  class BitPBR : public ElementWithVectorDataDefaultHash<u_int64_t, BitPBR> {
+   public:
+    //! Constructs a BitPBR defined by the vector pointed to by \p vector,
+    //! which is not copied, and should be deleted using
+    //! ElementWithVectorData::really_delete.
+    //!
+    //! If \f$n\f$ is the degree, then the parameter \p vector should consist
+    //! of \f$2n\f$ rows each of \f$\lceil 2n / 64 \rceil\f$ words, where bit
+    //! \f$j \bmod 64\f$ of word \f$\lfloor j / 64 \rfloor\f$ in row \f$i\f$
+    //! is set if and only if \f$i\f$ is adjacent to \f$j\f$. Any bits after
+    //! the \f$2n\f$-th in a row must be \c 0.
+    using ElementWithVectorDataDefaultHash<u_int64_t, BitPBR>::
+        ElementWithVectorDataDefaultHash;
+
+    //! Constructs a BitPBR from the lists of adjacent points \p adj.
+    //!
+    //! The parameter \p adj should be of the same form as the data used to
+    //! construct a PBR, i.e. it has length \f$2n\f$ for some integer \f$n\f$,
+    //! and the vector in position \f$i\f$ is the list of points adjacent to
+    //! \f$i\f$.
+    explicit BitPBR(std::vector<std::vector<u_int32_t>> const& adj);
+
+    //! Returns the approximate time complexity of multiplying BitPBRs.
+    //!
+    //! The approximate time complexity of multiplying BitPBRs is
+    //! \f$8n ^ 2\lceil 2n / 64 \rceil\f$ where \f$n\f$ is the degree.
+    size_t complexity() const override;
+
+    //! Returns the degree of a BitPBR.
+    //!
+    //! The *degree* of a BitPBR is half the number of points in the BitPBR.
+    size_t degree() const override;
+
+    //! Returns the identity BitPBR with degree equal to that of \c this.
+    //!
+    //! This method returns a new BitPBR with degree equal to the degree of
+    //! \c this where \f$i\f$ is adjacent \f$i + n\f$ and vice versa for every
+    //! \f$i\f$ less than the degree \f$n\f$.
+    Element* identity() const override;
+
+    //! Multiply \p x and \p y and stores the result in \c this.
+    //!
+    //! This method redefines \c this to be the product of the parameters \p x
+    //! and \p y. This method asserts that the degrees of \p x, \p y, and \c
+    //! this, are all equal, and that neither \p x nor \p y equals \c this.
+    //!
+    //! The parameter \p thread_id is required since some temporary storage is
+    //! required to find the product of \p x and \p y.  Note that if different
+    //! threads call this method with the same value of \p thread_id then bad
+    //! things will happen.
+    void redefine(Element const* x,
+                  Element const* y,
+                  size_t const&  thread_id) override;
+
+   private:
+    // Returns the number of words required to store nr_bits bits.
+    static inline size_t nr_words(size_t nr_bits) {
+      return (nr_bits + 63) / 64;
+    }
+
+    static std::vector<std::vector<u_int64_t>> _tmp;
+  };
+
   template <typename T> static inline void really_delete_cont(T cont) {
     for (Element const* x : cont) {
       const_cast<Element*>(x)->really_delete();
@@ -41,6 +41,11 @@ namespace libsemigroups {
       return x;
     }
 
+    inline void increase_degree_by(TElementType x, size_t m) const {
+      (void) x;
+      (void) m;
+    }
+
     inline void free(TElementType x) const {
       (void) x;
     }
@@ -70,8 +75,20 @@ namespace libsemigroups {
 #if defined(LIBSEMIGROUPS_HAVE_DENSEHASHMAP) \
     && defined(LIBSEMIGROUPS_USE_DENSEHASHMAP)
     inline TElementType empty_key(TElementType x) const {
+      return empty_key(x, 0);
+    }
+
+   private:
+    // Element types with a method empty_key, such as SmallPartialPerm, use
+    // it, and other types, such as BMat8, use TElementType(-1).
+    template <typename T>
+    static inline auto empty_key(T const& x, int) -> decltype(x.empty_key()) {
+      return x.empty_key();
+    }
+
+    template <typename T> static inline T empty_key(T const& x, long) {
       (void) x;
-      return TElementType(-1);
+      return T(-1);
     }
 #endif
   };
@@ -90,6 +107,10 @@ namespace libsemigroups {
       return x->really_copy(increase_deg_by);
     }
 
+    inline void increase_degree_by(TElementPointerType x, size_t m) const {
+      x->increase_degree_by(m);
+    }
+
     inline void free(TElementPointerType x) const {
       x->really_delete();
       delete x;
@@ -0,0 +1,86 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains a hash function for contiguous data, which is used by
+// the elements whose defining data are arrays of integers.
+//
+// The hash function only uses 64-bit integer arithmetic, and not CRC32C or
+// other SIMD instructions. It is inline in an installed header, and so it is
+// compiled with the flags of the code using libsemigroups, for which the
+// instructions checked for by configure may not be enabled.
+
+#ifndef LIBSEMIGROUPS_SRC_HASH_H_
+#define LIBSEMIGROUPS_SRC_HASH_H_
+
+#include <stddef.h>
+#include <string.h>
+
+#include <cstdint>
+
+namespace libsemigroups {
+
+  // Combines the 64-bit word w with the accumulator acc, in the same way as
+  // a round of xxHash64: multiplying by a large odd constant moves every bit
+  // of w towards the high bits, and the rotation moves them back.
+  static inline uint64_t hash_round(uint64_t acc, uint64_t w) {
+    acc += w * 0xc2b2ae3d27d4eb4f;
+    acc = (acc << 31) | (acc >> 33);
+    return acc * 0x9e3779b185ebca87;
+  }
+
+  //! Returns a hash value for the \p len bytes starting at \p data.
+  //!
+  //! The data is read 16 bytes at a time into two independent 64-bit lanes,
+  //! each of which is combined with its current value as in a round of
+  //! xxHash64, and the lanes are combined using the finalizer of
+  //! MurmurHash3. Every bit of the data affects every bit of the returned
+  //! value, unlike in the polynomial hash functions that combine one
+  //! integer at a time. The returned value depends on the byte order of the
+  //! machine.
+  static inline size_t hash_bytes(void const* data, size_t len) {
+    uint8_t const* p  = static_cast<uint8_t const*>(data);
+    uint64_t       h1 = len;
+    uint64_t       h2 = ~static_cast<uint64_t>(len);
+    uint64_t       w1, w2;
+    size_t         i = 0;
+    for (; i + 16 <= len; i += 16) {
+      memcpy(&w1, p + i, 8);
+      memcpy(&w2, p + i + 8, 8);
+      h1 = hash_round(h1, w1);
+      h2 = hash_round(h2, w2);
+    }
+    if (i + 8 <= len) {
+      memcpy(&w1, p + i, 8);
+      h1 = hash_round(h1, w1);
+      i += 8;
+    }
+    if (i < len) {
+      w2 = 0;
+      memcpy(&w2, p + i, len - i);
+      h2 = hash_round(h2, w2);
+    }
+    uint64_t h = h1 ^ (h2 * 0xc2b2ae3d27d4eb4f);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccd;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53;
+    h ^= h >> 33;
+    return h;
+  }
+}  // namespace libsemigroups
+#endif  // LIBSEMIGROUPS_SRC_HASH_H_
@@ -19,8 +19,10 @@
 #include "rws.h"
 
 #include <algorithm>
-#include <set>
+#include <functional>
+#include <limits>
 #include <string>
+#include <thread>
 
 namespace libsemigroups {
 
@@ -56,7 +58,6 @@ namespace libsemigroups {
     return std::equal(first_prefix, last_prefix, first_word);
   }
 
-#ifdef LIBSEMIGROUPS_DEBUG
   // Returns true if [first_suffix, last_suffix) is a suffix of [first_word,
   // last_word).
   static inline bool is_suffix(std::string::const_iterator const& first_word,
@@ -80,7 +81,6 @@ namespace libsemigroups {
     }
     return *it_suffix == *it_word;
   }
-#endif
 
   static inline std::pair<std::string::const_iterator,
                           std::string::const_iterator>
@@ -98,6 +98,161 @@ namespace libsemigroups {
 
   // Initialise static data members
   std::string const RWS::STANDARD_ALPHABET = "";
+  size_t const      RWS::UNBOUNDED;
+
+  RWS::RuleTrie::node_index_t const RWS::RuleTrie::ROOT;
+  RWS::RuleTrie::node_index_t const RWS::RuleTrie::UNDEFINED
+      = std::numeric_limits<RWS::RuleTrie::node_index_t>::max();
+
+  // RuleTrie
+
+  RWS::RuleTrie::RuleTrie()
+      : _children(0, 1, UNDEFINED),
+        _letter_to_col(std::numeric_limits<unsigned char>::max() + 1,
+                       UNDEFINED),
+        _link_version(1),
+        _nodes({Node(UNDEFINED, UNDEFINED)}),
+        _nr_rules(0),
+        _suffix_rule_version(1),
+        _total_length(0),
+        _valid(false) {}
+
+  bool RWS::RuleTrie::add_rule(Rule const* rule) {
+    LIBSEMIGROUPS_ASSERT(!rule->lhs()->empty());
+    node_index_t node      = ROOT;
+    bool         new_nodes = false;
+    for (rws_letter_t const& a : *rule->lhs()) {
+      size_t& col = _letter_to_col[static_cast<unsigned char>(a)];
+      if (col == UNDEFINED) {
+        // RecVec::add_cols does not reinitialise columns that were previously
+        // allocated but not used, and so we do this here.
+        col = _children.nr_cols();
+        _children.add_cols(1);
+        for (size_t i = 0; i < _children.nr_rows(); ++i) {
+          _children.set(i, col, UNDEFINED);
+        }
+      }
+      node_index_t next = _children.get(node, col);
+      if (next == UNDEFINED) {
+        next = _nodes.size();
+        _nodes.emplace_back(node, col);
+        _children.add_rows(1);
+        _children.set(node, col, next);
+        new_nodes = true;
+      }
+      node = next;
+    }
+    if (_nodes[node]._rule != nullptr) {
+      LIBSEMIGROUPS_ASSERT(!new_nodes);
+      return false;
+    }
+    _nodes[node]._rule = rule;
+    _nr_rules++;
+    _total_length += rule->lhs()->size();
+    if (new_nodes) {
+      // The suffix links of existing nodes can point to the new nodes.
+      _link_version++;
+    }
+    _suffix_rule_version++;
+    _valid = false;
+    return true;
+  }
+
+  void RWS::RuleTrie::remove_rule(Rule const* rule) {
+    node_index_t node = ROOT;
+    for (rws_letter_t const& a : *rule->lhs()) {
+      node = _children.get(node, _letter_to_col[static_cast<unsigned char>(a)]);
+      LIBSEMIGROUPS_ASSERT(node != UNDEFINED);
+    }
+    LIBSEMIGROUPS_ASSERT(_nodes[node]._rule == rule);
+    _nodes[node]._rule = nullptr;
+    _nr_rules--;
+    _total_length -= rule->lhs()->size();
+    _suffix_rule_version++;
+    _valid = false;
+    if (_nodes.size() > 2 * _total_length + 1024) {
+      rebuild();
+    }
+  }
+
+  RWS::RuleTrie::node_index_t RWS::RuleTrie::next_node(node_index_t node,
+                                                       rws_letter_t a) const {
+    size_t col = _letter_to_col[static_cast<unsigned char>(a)];
+    if (col == UNDEFINED) {
+      return ROOT;
+    }
+    return traverse(node, col);
+  }
+
+  RWS::Rule const* RWS::RuleTrie::rule(node_index_t node) const {
+    Node const& n = _nodes[node];
+    if (n._suffix_rule_version != _suffix_rule_version) {
+      if (n._rule != nullptr || node == ROOT) {
+        n._suffix_rule = n._rule;
+      } else {
+        n._suffix_rule = rule(link(node));
+      }
+      n._suffix_rule_version = _suffix_rule_version;
+    }
+    return n._suffix_rule;
+  }
+
+  void RWS::RuleTrie::compute_links() const {
+    if (!_valid) {
+      for (node_index_t node = ROOT; node < _nodes.size(); ++node) {
+        link(node);
+        rule(node);
+      }
+      _valid = true;
+    }
+  }
+
+  RWS::RuleTrie::node_index_t RWS::RuleTrie::link(node_index_t node) const {
+    Node const& n = _nodes[node];
+    if (n._link_version != _link_version) {
+      if (node == ROOT || n._parent == ROOT) {
+        n._link = ROOT;
+      } else {
+        n._link = traverse(link(n._parent), n._col);
+      }
+      n._link_version = _link_version;
+    }
+    return n._link;
+  }
+
+  RWS::RuleTrie::node_index_t RWS::RuleTrie::traverse(node_index_t node,
+                                                      size_t       col) const {
+    node_index_t next;
+    while ((next = _children.get(node, col)) == UNDEFINED) {
+      if (node == ROOT) {
+        return ROOT;
+      }
+      node = link(node);
+    }
+    return next;
+  }
+
+  // Discards the nodes not belonging to the path of the left hand side of any
+  // rule in the trie.
+  void RWS::RuleTrie::rebuild() {
+    std::vector<Rule const*> rules;
+    rules.reserve(_nr_rules);
+    for (Node const& n : _nodes) {
+      if (n._rule != nullptr) {
+        rules.push_back(n._rule);
+      }
+    }
+    _children = RecVec<node_index_t>(_children.nr_cols(), 1, UNDEFINED);
+    _nodes.clear();
+    _nodes.emplace_back(UNDEFINED, UNDEFINED);
+    _nr_rules     = 0;
+    _total_length = 0;
+    for (Rule const* rule : rules) {
+      add_rule(rule);
+    }
+    // The nodes are renumbered, and so all suffix links must be recomputed.
+    _link_version++;
+  }
 
 // Functions for when stats mode is enabled
 #ifdef LIBSEMIGROUPS_STATS
@@ -190,8 +345,6 @@ namespace libsemigroups {
   RWS::~RWS() {
     delete _order;
     delete _overlap_measure;
-    delete _tmp_word1;
-    delete _tmp_word2;
     for (Rule const* rule : _active_rules) {
       delete const_cast<Rule*>(rule);
     }
@@ -219,52 +372,94 @@ namespace libsemigroups {
   void RWS::add_rules(std::vector<relation_t> const& relations) {
     for (relation_t const& rel : relations) {
       if (rel.first != rel.second) {
-        add_rule(new_rule(word_to_rws_word(rel.first),
-                          word_to_rws_word(rel.second)));
+        Rule* rule = new_rule();
+        word_to_rws_word(rel.first, &rule->_lhs);
+        word_to_rws_word(rel.second, &rule->_rhs);
+        rule->reorder();
+        add_rule(rule);
       }
     }
   }
 
   void RWS::add_rule(std::string const& p, std::string const& q) {
     if (p != q) {
-      auto pp = new rws_word_t(p);
-      auto qq = new rws_word_t(q);
-      string_to_rws_word(*pp);
-      string_to_rws_word(*qq);
-      add_rule(new_rule(pp, qq));
+      Rule* rule = new_rule(p.cbegin(), p.cend(), q.cbegin(), q.cend());
+      string_to_rws_word(rule->_lhs);
+      string_to_rws_word(rule->_rhs);
+      rule->reorder();
+      add_rule(rule);
     }
   }
 
   // Private
   void RWS::add_rule(Rule* rule) {
+    LIBSEMIGROUPS_ASSERT(*rule->lhs() != *rule->rhs());
+    for (rws_word_t const* w : {rule->lhs(), rule->rhs()}) {
+      for (rws_letter_t const& a : *w) {
+        auto it = std::lower_bound(_letters.begin(), _letters.end(), a);
+        if (it == _letters.end() || *it != a) {
+          _letters.insert(it, a);
+          _nf_valid = false;
+        }
+      }
+    }
+    for (Rule const* active : _active_rules) {
+      if (is_suffix(rule->lhs()->cbegin(),
+                    rule->lhs()->cend(),
+                    active->lhs()->cbegin(),
+                    active->lhs()->cend())
+          || is_suffix(active->lhs()->cbegin(),
+                       active->lhs()->cend(),
+                       rule->lhs()->cbegin(),
+                       rule->lhs()->cend())) {
+        // The rules are not reduced, this should only happen if we are
+        // calling add_rule from outside the class (i.e. we are initialising
+        // the RWS).
+        push_stack(rule);
+        return;  // Do not activate or actually add the rule at this point
+      }
+    }
+    activate_rule(rule);
+  }
+
+  void RWS::activate_rule(Rule* rule) {
 #ifdef LIBSEMIGROUPS_STATS
     _max_word_length  = std::max(_max_word_length, rule->lhs()->size());
     _max_active_rules = std::max(_max_active_rules, _active_rules.size());
     _unique_lhs_rules.insert(*rule->lhs());
 #endif
     LIBSEMIGROUPS_ASSERT(*rule->lhs() != *rule->rhs());
-    if (!_set_rules.emplace(RuleLookup(rule)).second) {
-      // The rules are not reduced, this should only happen if we are calling
-      // add_rule from outside the class (i.e. we are initialising the RWS).
-      push_stack(rule);
-      return;  // Do not activate or actually add the rule at this point
-    }
+#ifdef LIBSEMIGROUPS_DEBUG
+    LIBSEMIGROUPS_ASSERT(_rule_trie.add_rule(rule));
+#else
+    _rule_trie.add_rule(rule);
+#endif
     rule->activate();
     _active_rules.push_back(rule);
+    _active_rules_bytes += rule_bytes(rule);
     if (_next_rule_it1 == _active_rules.end()) {
       --_next_rule_it1;
     }
     if (_next_rule_it2 == _active_rules.end()) {
       --_next_rule_it2;
     }
+    if (_unchecked_rule_it == _active_rules.end()) {
+      --_unchecked_rule_it;
+    }
     _confluence_known = false;
+    _nf_valid         = false;
+    ++_rules_version;
+    // These are not updated when rules are removed, and so they are only
+    // bounds for the lengths of the left hand sides of the active rules,
+    // which is all that RWS::internal_rewrite requires.
     if (rule->lhs()->size() < _min_length_lhs_rule) {
-      // FIXME this is not valid when using non-length reducing orderings (such
-      // as RECURSIVE)
       _min_length_lhs_rule = rule->lhs()->size();
     }
+    if (rule->lhs()->size() > _max_length_lhs_rule) {
+      _max_length_lhs_rule = rule->lhs()->size();
+    }
 
-    LIBSEMIGROUPS_ASSERT(_set_rules.size() == _active_rules.size());
+    LIBSEMIGROUPS_ASSERT(_rule_trie.nr_rules() == _active_rules.size());
   }
 
   std::list<RWS::Rule const*>::iterator
@@ -272,8 +467,12 @@ namespace libsemigroups {
 #ifdef LIBSEMIGROUPS_STATS
     _unique_lhs_rules.erase(*((*it)->lhs()));
 #endif
+    if (it == _unchecked_rule_it) {
+      ++_unchecked_rule_it;
+    }
     Rule* rule = const_cast<Rule*>(*it);
     rule->deactivate();
+    _active_rules_bytes -= rule_bytes(rule);
     if (it != _next_rule_it1 && it != _next_rule_it2) {
       it = _active_rules.erase(it);
     } else if (it == _next_rule_it1 && it != _next_rule_it2) {
@@ -287,12 +486,9 @@ namespace libsemigroups {
       _next_rule_it2 = _next_rule_it1;
       it             = _next_rule_it1;
     }
-#ifdef LIBSEMIGROUPS_DEBUG
-    LIBSEMIGROUPS_ASSERT(_set_rules.erase(RuleLookup(rule)) == 1);
-#else
-    _set_rules.erase(RuleLookup(rule));
-#endif
-    LIBSEMIGROUPS_ASSERT(_set_rules.size() == _active_rules.size());
+    _rule_trie.remove_rule(rule);
+    _nf_valid = false;
+    LIBSEMIGROUPS_ASSERT(_rule_trie.nr_rules() == _active_rules.size());
 
     return it;
   }
@@ -312,20 +508,10 @@ namespace libsemigroups {
     return rule;
   }
 
-  RWS::Rule* RWS::new_rule(rws_word_t* lhs, rws_word_t* rhs) const {
-    Rule* rule = new_rule();
-    delete rule->_lhs;
-    delete rule->_rhs;
-    rule->_lhs = lhs;
-    rule->_rhs = rhs;
-    rule->reorder();
-    return rule;
-  }
-
   RWS::Rule* RWS::new_rule(Rule const* rule1) const {
     Rule* rule2 = new_rule();
-    rule2->_lhs->append(*rule1->lhs());  // copies lhs
-    rule2->_rhs->append(*rule1->rhs());  // copies rhs
+    rule2->_lhs.append(*rule1->lhs());  // copies lhs
+    rule2->_rhs.append(*rule1->rhs());  // copies rhs
     return rule2;
   }
 
@@ -334,8 +520,8 @@ namespace libsemigroups {
                            rws_word_t::const_iterator begin_rhs,
                            rws_word_t::const_iterator end_rhs) const {
     Rule* rule = new_rule();
-    rule->_lhs->append(begin_lhs, end_lhs);
-    rule->_rhs->append(begin_rhs, end_rhs);
+    rule->_lhs.append(begin_lhs, end_lhs);
+    rule->_rhs.append(begin_rhs, end_rhs);
     return rule;
   }
 
@@ -361,7 +547,7 @@ namespace libsemigroups {
   }
 
   bool RWS::rule(std::string p, std::string q) const {
-    // TODO Could use a RuleLookup and instead of this!
+    // TODO Could use _rule_trie instead of this!
     // take references and then copy into _tmp_word1/2
     string_to_rws_word(p);
     string_to_rws_word(q);
@@ -375,42 +561,293 @@ namespace libsemigroups {
     return false;
   }
 
+  bool RWS::is_reduced(std::string const& w) const {
+    RuleTrie::node_index_t node = RuleTrie::ROOT;
+    for (char a : w) {
+      if (_alphabet != STANDARD_ALPHABET) {
+        a = char_to_rws_letter(a);
+      }
+      node = _rule_trie.next_node(node, a);
+      if (_rule_trie.rule(node) != nullptr) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The automaton is the Aho-Corasick automaton _rule_trie restricted to the
+  // nodes reachable from the root by reading irreducible words, i.e. those
+  // nodes which have no suffix which is the left hand side of a rule. Every
+  // state is accepting, and the state 0 corresponds to the root.
+  void RWS::init_normal_forms() {
+    if (_nf_valid) {
+      return;
+    }
+    _rule_trie.compute_links();
+    std::vector<size_t> node_to_state(_rule_trie.nr_nodes(),
+                                      RuleTrie::UNDEFINED);
+    std::vector<RuleTrie::node_index_t> state_to_node;
+
+    // RecVec::operator= does not change the default value of _nf_automaton,
+    // which is RuleTrie::UNDEFINED.
+    _nf_automaton = RecVec<size_t>(_letters.size(), 1, RuleTrie::UNDEFINED);
+    node_to_state[RuleTrie::ROOT] = 0;
+    state_to_node.push_back(RuleTrie::ROOT);
+    for (size_t s = 0; s < state_to_node.size(); ++s) {
+      for (size_t i = 0; i < _letters.size(); ++i) {
+        RuleTrie::node_index_t node
+            = _rule_trie.next_node(state_to_node[s], _letters[i]);
+        if (_rule_trie.rule(node) == nullptr) {
+          if (node_to_state[node] == RuleTrie::UNDEFINED) {
+            node_to_state[node] = state_to_node.size();
+            state_to_node.push_back(node);
+            _nf_automaton.add_rows(1);
+          }
+          _nf_automaton.set(s, i, node_to_state[node]);
+        }
+      }
+    }
+
+    // Depth first search to find the length of the longest path from every
+    // state, which is infinite if a state on the current path is reachable.
+    size_t const      nr_states = state_to_node.size();
+    std::vector<bool> on_path(nr_states, false);
+    _nf_depth.assign(nr_states, RuleTrie::UNDEFINED);
+    _nf_nr_paths.assign(nr_states, 1);
+    std::vector<std::pair<size_t, size_t>> path;  // state, next letter
+    path.emplace_back(0, 0);
+    on_path[0] = true;
+    while (!path.empty()) {
+      size_t  s = path.back().first;
+      size_t& i = path.back().second;
+      if (i < _letters.size()) {
+        size_t t = _nf_automaton.get(s, i++);
+        if (t != RuleTrie::UNDEFINED && _nf_depth[t] == RuleTrie::UNDEFINED
+            && !on_path[t]) {
+          on_path[t] = true;
+          path.emplace_back(t, 0);
+        }
+        continue;
+      }
+      path.pop_back();
+      size_t depth = 0;
+      for (auto it = _nf_automaton.cbegin_row(s);
+           it < _nf_automaton.cend_row(s);
+           ++it) {
+        if (*it != RuleTrie::UNDEFINED) {
+          if (on_path[*it] || _nf_depth[*it] == UNBOUNDED) {
+            depth = UNBOUNDED;
+          } else if (depth != UNBOUNDED) {
+            depth = std::max(depth, _nf_depth[*it] + 1);
+          }
+          _nf_nr_paths[s] += _nf_nr_paths[*it];
+        }
+      }
+      _nf_depth[s] = depth;
+      on_path[s]   = false;
+    }
+    _nf_valid = true;
+  }
+
+  size_t RWS::nr_normal_forms(size_t min, size_t max) {
+    knuth_bendix();
+    init_normal_forms();
+    size_t const nr_states = _nf_depth.size();
+    size_t       last      = std::min(max, _nf_depth[0] + 1);
+    if (max == UNBOUNDED) {
+      if (_nf_depth[0] == UNBOUNDED) {
+        return UNBOUNDED;
+      }
+      // Count the normal forms of length less than <min> and subtract them
+      // from the total number of normal forms.
+      last = std::min(min, _nf_depth[0] + 1);
+    }
+    // count[s] is the number of paths of length <len> starting at the state s
+    std::vector<size_t> count(nr_states, 1);
+    std::vector<size_t> next(nr_states, 0);
+    size_t              nr = 0;
+    for (size_t len = 0; len < last; ++len) {
+      if (len >= min || max == UNBOUNDED) {
+        nr += count[0];
+      }
+      for (size_t s = 0; s < nr_states; ++s) {
+        next[s] = 0;
+        for (auto it = _nf_automaton.cbegin_row(s);
+             it < _nf_automaton.cend_row(s);
+             ++it) {
+          if (*it != RuleTrie::UNDEFINED) {
+            next[s] += count[*it];
+          }
+        }
+      }
+      std::swap(count, next);
+    }
+    if (max == UNBOUNDED) {
+      return _nf_nr_paths[0] - nr;
+    }
+    return nr;
+  }
+
+  void RWS::normal_forms(size_t                                   min,
+                         size_t                                   max,
+                         std::function<bool(std::string const&)> hook) {
+    knuth_bendix();
+    init_normal_forms();
+    std::string letters(_letters);
+    rws_word_to_string(letters);
+
+    // states[i] is the state reached by reading the first i letters of word,
+    // and cols[i] is the next letter to try in position i.
+    std::vector<size_t> states;
+    std::vector<size_t> cols;
+    std::string         word;
+    for (size_t len = min; len < max && len <= _nf_depth[0]; ++len) {
+      states.assign(len + 1, 0);
+      cols.assign(len + 1, 0);
+      word.assign(len, 0);
+      size_t pos = 0;
+      while (true) {
+        if (pos == len) {
+          if (!hook(word)) {
+            return;
+          } else if (pos == 0) {
+            break;
+          }
+          --pos;
+          continue;
+        }
+        size_t i = cols[pos];
+        size_t t = RuleTrie::UNDEFINED;
+        // Only use a letter if there is a path of length len - pos - 1 from
+        // the state reached by reading it.
+        for (; i < _letters.size(); ++i) {
+          t = _nf_automaton.get(states[pos], i);
+          if (t != RuleTrie::UNDEFINED && _nf_depth[t] >= len - pos - 1) {
+            break;
+          }
+        }
+        if (i == _letters.size()) {
+          if (pos == 0) {
+            break;
+          }
+          --pos;
+          continue;
+        }
+        cols[pos]       = i + 1;
+        word[pos]       = letters[i];
+        states[pos + 1] = t;
+        ++pos;
+        cols[pos] = 0;
+      }
+    }
+  }
+
+  void RWS::rewrite(std::vector<std::string>* words) const {
+    batch(words->size(), [this, words](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        rewrite(&(*words)[i]);
+      }
+    });
+  }
+
+  void RWS::batch(size_t n, std::function<void(size_t, size_t)> func) const {
+    // The minimum number of words for each thread
+    size_t const min_batch_size = 1024;
+
+    size_t nr_threads
+        = std::max(std::min(_max_threads, n / min_batch_size), size_t(1));
+    if (nr_threads == 1) {
+      func(0, n);
+      return;
+    }
+    // The words are rewritten concurrently and so the trie must not be
+    // modified during rewriting.
+    _rule_trie.compute_links();
+
+    size_t const             batch_size = ((n / nr_threads) / 64 + 1) * 64;
+    std::vector<std::thread> threads;
+    for (size_t first = 0; first < n; first += batch_size) {
+      threads.push_back(
+          std::thread(func, first, std::min(first + batch_size, n)));
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  }
+
   // REWRITE_FROM_LEFT from Sims, p67
-  // Caution: this uses the assumption that rules are length reducing, if it is
-  // not, then u might not have sufficient space!
-  void RWS::internal_rewrite(rws_word_t* u) const {
-    if (u->size() < _min_length_lhs_rule) {
+  void RWS::internal_rewrite(rws_word_t* u, size_t pos) const {
+    if (u->size() < _min_length_lhs_rule || pos >= u->size()) {
       return;
     }
-    rws_word_t::iterator const& v_begin = u->begin();
-    rws_word_t::iterator        v_end   = u->begin() + _min_length_lhs_rule - 1;
-    rws_word_t::iterator        w_begin = v_end;
-    rws_word_t::iterator const& w_end   = u->end();
+    // Since no left hand side of a rule occurs in the first <pos> letters of
+    // u, every left hand side occurring in u starts at or after <start>, and
+    // so we start reading u there, until a rule is applied whose left hand
+    // side starts before <pos>.
+    size_t start = 0;
+    if (pos >= _max_length_lhs_rule) {
+      start = pos - _max_length_lhs_rule + 1;
+    }
+    rws_word_t::iterator v_end   = u->begin() + start;
+    rws_word_t::iterator w_begin = v_end;
+    rws_word_t::iterator w_end   = u->end();
 
-    RuleLookup lookup;
+    // nodes[i] is the node of _rule_trie reached after reading the first i
+    // letters of [u->begin(), v_end), so that after a rule is applied we can
+    // continue from the node reached before reading its left hand side. The
+    // nodes are stored on the stack, and not allocated, unless u is long.
+    RuleTrie::node_index_t              short_nodes[64];
+    std::vector<RuleTrie::node_index_t> long_nodes;
+    RuleTrie::node_index_t*             nodes = short_nodes;
+    if (u->size() >= 64) {
+      long_nodes.resize(u->size() + 1);
+      nodes = long_nodes.data();
+    }
+    nodes[0]     = RuleTrie::ROOT;
+    nodes[start] = RuleTrie::ROOT;
 
     while (w_begin != w_end) {
       *v_end = *w_begin;
-      ++v_end;
       ++w_begin;
+      size_t i = v_end - u->begin();
+      nodes[i + 1] = _rule_trie.next_node(nodes[i], *v_end);
+      ++v_end;
 
-      auto it = _set_rules.find(lookup(v_begin, v_end));
-      if (it != _set_rules.end()) {
-        Rule const* rule = (*it).rule();
-        if (rule->lhs()->size() <= static_cast<size_t>(v_end - v_begin)) {
-          LIBSEMIGROUPS_ASSERT(is_suffix(
-              v_begin, v_end, rule->lhs()->cbegin(), rule->lhs()->cend()));
-          v_end -= rule->lhs()->size();
-          w_begin -= rule->rhs()->size();
-          string_replace(w_begin, rule->rhs()->cbegin(), rule->rhs()->cend());
+      Rule const* rule = _rule_trie.rule(nodes[i + 1]);
+      if (rule != nullptr) {
+        LIBSEMIGROUPS_ASSERT(is_suffix(
+            u->begin(), v_end, rule->lhs()->cbegin(), rule->lhs()->cend()));
+        v_end -= rule->lhs()->size();
+        if (start != 0 && static_cast<size_t>(v_end - u->begin()) < pos) {
+          // The nodes before position <pos> were found by reading u from
+          // <start> and not from the beginning, and so they might be wrong.
+          size_t const v_pos = v_end - u->begin();
+          for (size_t k = 0; k < v_pos; ++k) {
+            nodes[k + 1] = _rule_trie.next_node(nodes[k], (*u)[k]);
+          }
+          start = 0;
         }
-      }
-      while (w_begin != w_end
-             && _min_length_lhs_rule - 1
-                    > static_cast<size_t>((v_end - v_begin))) {
-        *v_end = *w_begin;
-        ++v_end;
-        ++w_begin;
+        if (rule->rhs()->size() > static_cast<size_t>(w_begin - v_end)) {
+          // The rule is not length reducing (for example, if the reduction
+          // ordering is RECURSIVE), and there is not enough space before
+          // w_begin for its right hand side, so we make some.
+          size_t v_pos = v_end - u->begin();
+          size_t w_pos = w_begin - u->begin();
+          size_t extra = rule->rhs()->size() - (w_pos - v_pos);
+          u->insert(w_pos, extra, 0);
+          v_end   = u->begin() + v_pos;
+          w_begin = u->begin() + w_pos + extra;
+          w_end   = u->end();
+          if (u->size() >= 64 && u->size() >= long_nodes.size()) {
+            if (long_nodes.empty()) {
+              long_nodes.assign(short_nodes, short_nodes + v_pos + 1);
+            }
+            long_nodes.resize(u->size() + 1);
+            nodes = long_nodes.data();
+          }
+        }
+        w_begin -= rule->rhs()->size();
+        string_replace(w_begin, rule->rhs()->cbegin(), rule->rhs()->cend());
       }
     }
     u->erase(v_end - u->cbegin());
@@ -423,47 +860,78 @@ namespace libsemigroups {
       LIBSEMIGROUPS_ASSERT(_stack.empty());
       _confluent        = true;
       _confluence_known = true;
-      rws_word_t word1;
-      rws_word_t word2;
-
-      for (auto it1 = _active_rules.cbegin();
-           it1 != _active_rules.cend() && !killed;
-           ++it1) {
-        Rule const* rule1 = *it1;
-        // Seems to be much faster to do this in reverse.
-        for (auto it2 = _active_rules.crbegin();
-             it2 != _active_rules.crend() && !killed;
-             ++it2) {
-          Rule const* rule2 = *it2;
-          for (auto it = rule1->lhs()->cend() - 1;
-               it >= rule1->lhs()->cbegin() && !killed;
-               --it) {
-            // Find longest common prefix of suffix B of rule1.lhs() defined
-            // by it and R = rule2.lhs()
-            auto prefix = maximum_common_prefix(it,
-                                                rule1->lhs()->cend(),
-                                                rule2->lhs()->cbegin(),
-                                                rule2->lhs()->cend());
-            if (prefix.first == rule1->lhs()->cend()
-                || prefix.second == rule2->lhs()->cend()) {
-              word1.clear();
-              word1.append(rule1->lhs()->cbegin(), it);          // A
-              word1.append(*rule2->rhs());                       // S
-              word1.append(prefix.first, rule1->lhs()->cend());  // D
-
-              word2.clear();
-              word2.append(*rule1->rhs());                        // Q
-              word2.append(prefix.second, rule2->lhs()->cend());  // E
-
-              if (word1 != word2) {
-                internal_rewrite(&word1);
-                internal_rewrite(&word2);
-                if (word1 != word2) {
-                  _confluent = false;
-                  return _confluent;
-                }
-              }
+      // The overlaps of the rules before _unchecked_rule_it with each other
+      // were shown to resolve in a previous call to this method. This remains
+      // true even if rules are removed from, or added to the end of,
+      // _active_rules, or if the right hand sides of rules are rewritten, and
+      // so we only check the overlaps of the remaining rules.
+      if (_max_threads <= 1) {
+        rws_word_t word1;
+        rws_word_t word2;
+        for (; _unchecked_rule_it != _active_rules.end();
+             ++_unchecked_rule_it) {
+          Rule const* rule1 = *_unchecked_rule_it;
+          // Seems to be much faster to do this in reverse, starting with
+          // rule1 itself.
+          auto it = _unchecked_rule_it;
+          ++it;
+          do {
+            --it;
+            Rule const* rule2 = *it;
+            if (!resolves(rule1, rule2, word1, word2, killed)
+                || (rule1 != rule2
+                    && !resolves(rule2, rule1, word1, word2, killed))) {
+              _confluent = false;
+              return _confluent;
             }
+          } while (it != _active_rules.begin() && !killed);
+          if (killed) {
+            break;
+          }
+        }
+      } else {
+        // The minimum number of pairs of rules checked by the threads at once
+        size_t const batch_size = 4096;
+
+        std::vector<Rule const*> rules(_active_rules.cbegin(),
+                                       _active_rules.cend());
+        size_t first = std::distance(
+            _active_rules.begin(),
+            std::list<Rule const*>::const_iterator(_unchecked_rule_it));
+        // The rules are rewritten concurrently and so the trie must not be
+        // modified during rewriting.
+        _rule_trie.compute_links();
+
+        while (first < rules.size() && !killed) {
+          size_t last     = first;
+          size_t nr_pairs = 0;
+          do {
+            nr_pairs += 2 * last + 1;
+            ++last;
+          } while (last < rules.size() && nr_pairs < batch_size);
+
+          size_t nr_threads = std::min(_max_threads, last - first);
+          std::atomic<bool>        failed(false);
+          std::vector<std::thread> threads;
+          for (size_t i = 0; i < nr_threads; ++i) {
+            threads.push_back(std::thread(&RWS::resolve_batch,
+                                          this,
+                                          std::cref(rules),
+                                          first + i,
+                                          last,
+                                          nr_threads,
+                                          std::ref(killed),
+                                          std::ref(failed)));
+          }
+          for (size_t i = 0; i < nr_threads; ++i) {
+            threads[i].join();
+          }
+          if (failed) {
+            _confluent = false;
+            return _confluent;
+          } else if (!killed) {
+            std::advance(_unchecked_rule_it, last - first);
+            first = last;
           }
         }
       }
@@ -474,6 +942,73 @@ namespace libsemigroups {
     return _confluent;
   }
 
+  // Returns false if there is an overlap of a suffix of the left hand side of
+  // <rule1> with a prefix of the left hand side of <rule2>, or of the left
+  // hand side of <rule2> with a subword of that of <rule1>, which does not
+  // resolve, i.e. such that the two words obtained by applying the rules to
+  // the overlap have distinct normal forms. If <killed> or <failed> becomes
+  // true, then this returns true without checking the remaining overlaps.
+  bool RWS::resolves(Rule const*              rule1,
+                     Rule const*              rule2,
+                     rws_word_t&              word1,
+                     rws_word_t&              word2,
+                     std::atomic<bool> const& killed,
+                     std::atomic<bool> const& failed) const {
+    for (auto it = rule1->lhs()->cend() - 1;
+         it >= rule1->lhs()->cbegin() && !killed && !failed;
+         --it) {
+      // Find longest common prefix of suffix B of rule1.lhs() defined
+      // by it and R = rule2.lhs()
+      auto prefix = maximum_common_prefix(it,
+                                          rule1->lhs()->cend(),
+                                          rule2->lhs()->cbegin(),
+                                          rule2->lhs()->cend());
+      if (prefix.first == rule1->lhs()->cend()
+          || prefix.second == rule2->lhs()->cend()) {
+        word1.clear();
+        word1.append(rule1->lhs()->cbegin(), it);          // A
+        word1.append(*rule2->rhs());                       // S
+        word1.append(prefix.first, rule1->lhs()->cend());  // D
+
+        word2.clear();
+        word2.append(*rule1->rhs());                        // Q
+        word2.append(prefix.second, rule2->lhs()->cend());  // E
+
+        if (word1 != word2) {
+          internal_rewrite(&word1);
+          internal_rewrite(&word2);
+          if (word1 != word2) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  // Checks if the overlaps of the rules in positions <first>, <first> +
+  // <step>, ..., up to <last> (not inclusive), of <rules> with the rules
+  // preceding them resolve, and sets <failed> to true if one does not.
+  void RWS::resolve_batch(std::vector<Rule const*> const& rules,
+                          size_t                          first,
+                          size_t                          last,
+                          size_t                          step,
+                          std::atomic<bool>&              killed,
+                          std::atomic<bool>&              failed) const {
+    rws_word_t word1;
+    rws_word_t word2;
+    for (size_t i = first; i < last && !killed && !failed; i += step) {
+      for (size_t j = i + 1; j-- > 0 && !killed && !failed;) {
+        if (!resolves(rules[i], rules[j], word1, word2, killed, failed)
+            || (i != j
+                && !resolves(
+                       rules[j], rules[i], word1, word2, killed, failed))) {
+          failed = true;
+        }
+      }
+    }
+  }
+
   // TEST_2 from Sims, p76
   void RWS::clear_stack(std::atomic<bool>& killed) {
     while (!_stack.empty() && !killed) {
@@ -498,14 +1033,16 @@ namespace libsemigroups {
             _stack.emplace(rule2);
           } else {
             if (rule2->rhs()->find(*lhs) != std::string::npos) {
+              _active_rules_bytes -= rule2->rhs()->size();
               rule2->rewrite_rhs();
+              _active_rules_bytes += rule2->rhs()->size();
             }
             ++it;
           }
         }
-        add_rule(rule1);
+        activate_rule(rule1);
         // rule1 is activated, we do this after removing rules that rule1 makes
-        // redundant to avoid failing to insert rule1 in _set_rules
+        // redundant, so that no active rule has the same left hand side
       } else {
         _inactive_rules.push_back(rule1);
       }
@@ -556,17 +1093,16 @@ namespace libsemigroups {
       // Check if B = [it, u->lhs()->cend()) is a prefix of v->lhs()
       if (is_prefix(
               v->lhs()->cbegin(), v->lhs()->cend(), it, u->lhs()->cend())) {
-        // u = P_i = AB -> Q_i and v = P_j = BC -> Q_j
-        // This version of new_rule does not reorder
-        Rule* rule = new_rule(u->lhs()->cbegin(),
-                              it,
-                              u->rhs()->cbegin(),
-                              u->rhs()->cend());  // rule = A -> Q_i
-        rule->_lhs->append(*v->rhs());            // rule = AQ_j -> Q_i
-        rule->_rhs->append(v->lhs()->cbegin() + (u->lhs()->cend() - it),
-                           v->lhs()->cend());  // rule = AQ_j -> Q_iC
-        // rule is reordered during rewriting in clear_stack
-        push_stack(rule, killed);
+        if (_max_memory != UNBOUNDED && memory_used() > _max_memory) {
+          _deferred.push(DeferredOverlap{
+              (*_overlap_measure)(u, v, it),
+              _nr_deferred++,
+              static_cast<size_t>(it - u->lhs()->cbegin()),
+              u,
+              v});
+          continue;
+        }
+        push_overlap(u, v, it, killed);
         // It can be that the iterator `it` is invalidated by the call to
         // push_stack (i.e. if `u` is deactivated, then rewritten, actually
         // changed, and reactivated) and that is the reason for the checks in
@@ -578,6 +1114,181 @@ namespace libsemigroups {
     }
   }
 
+  void RWS::push_overlap(Rule const*                       u,
+                         Rule const*                       v,
+                         rws_word_t::const_iterator const& it,
+                         std::atomic<bool>&                killed) {
+    // u = P_i = AB -> Q_i and v = P_j = BC -> Q_j
+    // This version of new_rule does not reorder
+    Rule* rule = new_rule(u->lhs()->cbegin(),
+                          it,
+                          u->rhs()->cbegin(),
+                          u->rhs()->cend());  // rule = A -> Q_i
+    rule->_lhs.append(*v->rhs());             // rule = AQ_j -> Q_i
+    rule->_rhs.append(v->lhs()->cbegin() + (u->lhs()->cend() - it),
+                      v->lhs()->cend());  // rule = AQ_j -> Q_iC
+    // rule is reordered during rewriting in clear_stack
+    push_stack(rule, killed);
+  }
+
+  size_t RWS::rule_bytes(Rule const* rule) {
+    return sizeof(Rule) + rule->lhs()->size() + rule->rhs()->size();
+  }
+
+  size_t RWS::memory_used() const {
+    return _active_rules_bytes + _stack.size() * sizeof(Rule)
+           + _deferred.size() * sizeof(DeferredOverlap);
+  }
+
+  void RWS::resume_overlaps(std::atomic<bool>& killed) {
+    do {
+      DeferredOverlap overlap = _deferred.top();
+      _deferred.pop();
+      Rule const* u = overlap._u;
+      Rule const* v = overlap._v;
+      // The rules u and v may have been deactivated, or deactivated and
+      // reactivated with different left hand sides, since the overlap was
+      // deferred. In the former case, the overlap does not have to be
+      // considered, and in the latter case, the overlaps of u and v are
+      // considered again anyway, but we check that the overlap still exists,
+      // before pushing it.
+      if (u->active() && v->active() && overlap._pos > 0
+          && overlap._pos < u->lhs()->size()) {
+        auto it = u->lhs()->cbegin() + overlap._pos;
+        if (is_prefix(
+                v->lhs()->cbegin(), v->lhs()->cend(), it, u->lhs()->cend())) {
+          push_overlap(u, v, it, killed);
+        }
+      }
+    } while (!_deferred.empty() && !killed && memory_used() <= _max_memory
+             && _active_rules.size() < _max_rules);
+    if (_report_next++ > _report_interval) {
+      REPORT("active rules = " << _active_rules.size()
+                               << ", deferred overlaps = " << _deferred.size());
+      _report_next = 0;
+    }
+  }
+
+  void RWS::overlap(
+      Rule const*                                     u,
+      Rule const*                                     v,
+      std::atomic<bool>&                              killed,
+      std::vector<std::pair<rws_word_t, rws_word_t>>& pairs) const {
+    LIBSEMIGROUPS_ASSERT(u->active() && v->active());
+    auto limit
+        = u->lhs()->cend() - std::min(u->lhs()->size(), v->lhs()->size());
+    for (auto it = u->lhs()->cend() - 1;
+         it > limit && !killed
+         && (_max_overlap == UNBOUNDED
+             || (*_overlap_measure)(u, v, it) <= _max_overlap);
+         --it) {
+      // Check if B = [it, u->lhs()->cend()) is a prefix of v->lhs()
+      if (is_prefix(
+              v->lhs()->cbegin(), v->lhs()->cend(), it, u->lhs()->cend())) {
+        // u = P_i = AB -> Q_i and v = P_j = BC -> Q_j
+        rws_word_t lhs(u->lhs()->cbegin(), it);  // A
+        lhs.append(*v->rhs());                   // AQ_j
+        rws_word_t rhs(*u->rhs());               // Q_i
+        rhs.append(v->lhs()->cbegin() + (u->lhs()->cend() - it),
+                   v->lhs()->cend());  // Q_iC
+        internal_rewrite(&lhs);
+        internal_rewrite(&rhs);
+        if (lhs != rhs) {
+          pairs.emplace_back(std::move(lhs), std::move(rhs));
+        }
+      }
+    }
+  }
+
+  // The pairs of rules considered by RWS::knuth_bendix for the rule in
+  // position i of <rules> are numbered 0, ..., 2i, where 0 is the pair (i, i),
+  // and 2m - 1 and 2m are the pairs (i, i - m) and (i - m, i), respectively.
+  // The pairs for the rule in position <rule1> are followed by those for the
+  // rule in position <rule1> + 1, and so on.
+  void RWS::overlaps(
+      std::vector<Rule const*> const&                 rules,
+      size_t                                          rule1,
+      size_t                                          first,
+      size_t                                          last,
+      std::atomic<bool>&                              killed,
+      std::vector<std::pair<rws_word_t, rws_word_t>>& pairs) const {
+    size_t n = 0;  // the number of the first pair for the rule in position i
+    for (size_t i = rule1; i < rules.size() && n < last && !killed; ++i) {
+      size_t nr_pairs = 2 * i + 1;
+      for (size_t k = (first > n ? first - n : 0);
+           k < nr_pairs && n + k < last && !killed;
+           ++k) {
+        size_t j = i - (k + 1) / 2;
+        if (k % 2 == 1) {
+          overlap(rules[i], rules[j], killed, pairs);
+        } else {
+          overlap(rules[j], rules[i], killed, pairs);
+        }
+      }
+      n += nr_pairs;
+    }
+  }
+
+  // Computes, using up to _max_threads threads, the overlaps of a batch of
+  // active rules, starting from _next_rule_it1, with the active rules
+  // preceding them, and then adds the resulting rules to the system, in the
+  // order that they would be found using a single thread. Since the overlaps
+  // are computed using the rules active at the start of the batch, the rules
+  // are rewritten again when they are added. Returns the number of pairs of
+  // rules considered.
+  size_t RWS::overlap_batch(std::atomic<bool>& killed) {
+    // The minimum number of pairs of rules in a batch
+    size_t const batch_size = 4096;
+
+    std::vector<Rule const*> rules(_active_rules.begin(), _next_rule_it1);
+    size_t const             rule1    = rules.size();
+    size_t                   nr_pairs = 0;
+    do {
+      nr_pairs += 2 * rules.size() + 1;
+      rules.push_back(*_next_rule_it1);
+      ++_next_rule_it1;
+    } while (_next_rule_it1 != _active_rules.end() && nr_pairs < batch_size);
+
+    // The rules are rewritten concurrently and so the trie must not be
+    // modified during rewriting.
+    _rule_trie.compute_links();
+
+    size_t nr_threads = std::min(_max_threads, nr_pairs);
+    std::vector<std::vector<std::pair<rws_word_t, rws_word_t>>> pairs(
+        nr_threads);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < nr_threads; ++i) {
+      threads.push_back(std::thread(&RWS::overlaps,
+                                    this,
+                                    std::cref(rules),
+                                    rule1,
+                                    i * nr_pairs / nr_threads,
+                                    (i + 1) * nr_pairs / nr_threads,
+                                    std::ref(killed),
+                                    std::ref(pairs[i])));
+    }
+    for (size_t i = 0; i < nr_threads; ++i) {
+      threads[i].join();
+    }
+
+    for (auto const& thread_pairs : pairs) {
+      for (auto const& pair : thread_pairs) {
+        if (killed || _active_rules.size() >= _max_rules) {
+          // The remaining pairs are considered again if knuth_bendix is
+          // called again.
+          return nr_pairs;
+        }
+        // This version of new_rule does not reorder
+        push_stack(new_rule(pair.first.cbegin(),
+                            pair.first.cend(),
+                            pair.second.cbegin(),
+                            pair.second.cend()),
+                   killed);
+      }
+    }
+    return nr_pairs;
+  }
+
   // KBS_2 from Sims, p77-78
   void RWS::knuth_bendix(std::atomic<bool>& killed) {
     Timer timer;
@@ -586,8 +1297,10 @@ namespace libsemigroups {
       // RWS.  If _stack is non-empty, then it means that the rules in
       // _active_rules might not define the system.
       REPORT("the system is confluent already");
+      _rule_trie.compute_links();
       return;
     } else if (_active_rules.size() >= _max_rules) {
+      _rule_trie.compute_links();
       return;
     }
     // Reduce the rules
@@ -602,20 +1315,33 @@ namespace libsemigroups {
     }
     _next_rule_it1 = _active_rules.begin();
     size_t nr      = 0;
-    while (_next_rule_it1 != _active_rules.cend() && !killed
-           && _active_rules.size() < _max_rules) {
-      Rule const* rule1 = *_next_rule_it1;
-      _next_rule_it2    = _next_rule_it1;
-      ++_next_rule_it1;
-      overlap(rule1, rule1, killed);
-      while (_next_rule_it2 != _active_rules.begin() && rule1->active()) {
-        --_next_rule_it2;
-        Rule const* rule2 = *_next_rule_it2;
-        overlap(rule1, rule2, killed);
-        ++nr;
-        if (rule1->active() && rule2->active()) {
+    while ((_next_rule_it1 != _active_rules.cend() || !_deferred.empty())
+           && !killed && _active_rules.size() < _max_rules) {
+      if (_next_rule_it1 == _active_rules.cend()) {
+        // All the overlaps of the active rules, except those deferred, have
+        // been considered, and so we consider those deferred, which might
+        // activate further rules.
+        resume_overlaps(killed);
+        clear_stack(killed);
+        continue;
+      } else if (_max_threads > 1
+                 && (_max_memory == UNBOUNDED
+                     || memory_used() <= _max_memory)) {
+        nr += overlap_batch(killed);
+      } else {
+        Rule const* rule1 = *_next_rule_it1;
+        _next_rule_it2    = _next_rule_it1;
+        ++_next_rule_it1;
+        overlap(rule1, rule1, killed);
+        while (_next_rule_it2 != _active_rules.begin() && rule1->active()) {
+          --_next_rule_it2;
+          Rule const* rule2 = *_next_rule_it2;
+          overlap(rule1, rule2, killed);
           ++nr;
-          overlap(rule2, rule1, killed);
+          if (rule1->active() && rule2->active()) {
+            ++nr;
+            overlap(rule2, rule1, killed);
+          }
         }
       }
       if (nr > _check_confluence_interval) {
@@ -628,6 +1354,10 @@ namespace libsemigroups {
         clear_stack(killed);
       }
     }
+    // The deferred overlaps refer to the active rules, and so they cannot be
+    // kept if knuth_bendix is called again, after the system is changed.
+    _deferred    = decltype(_deferred)();
+    _nr_deferred = 0;
     if (killed) {
       REPORT("killed");
     } else {
@@ -650,6 +1380,9 @@ namespace libsemigroups {
 #endif
       REPORT("elapsed time = " << timer);
     }
+    // So that RWS::rewrite can be called concurrently, for example, when
+    // enumerating a Semigroup of RWSE's.
+    _rule_trie.compute_links();
   }
 
   // Main method
@@ -657,9 +1390,6 @@ namespace libsemigroups {
     if (*p == *q) {
       return true;
     }
-    if (p->size() < _min_length_lhs_rule && q->size() < _min_length_lhs_rule) {
-      return p == q;
-    }
     knuth_bendix();
     string_to_rws_word(*p);
     internal_rewrite(p);
@@ -669,8 +1399,18 @@ namespace libsemigroups {
   }
 
   bool RWS::test_equals(word_t const& p, word_t const& q) {
-    return test_equals(word_to_rws_word(p, _tmp_word1),
-                       word_to_rws_word(q, _tmp_word2));
+    // The words are not passed to test_equals(std::string*, std::string*)
+    // since they are already rws_word_t's, and must not be converted using
+    // the alphabet.
+    word_to_rws_word(p, &_tmp_word1);
+    word_to_rws_word(q, &_tmp_word2);
+    if (_tmp_word1 == _tmp_word2) {
+      return true;
+    }
+    knuth_bendix();
+    internal_rewrite(&_tmp_word1);
+    internal_rewrite(&_tmp_word2);
+    return _tmp_word1 == _tmp_word2;
   }
 
   bool RWS::test_equals(std::initializer_list<size_t> const& p,
@@ -679,11 +1419,51 @@ namespace libsemigroups {
   }
 
   bool RWS::test_equals(std::string const& p, std::string const& q) {
-    _tmp_word1->replace(
-        _tmp_word1->begin(), _tmp_word1->end(), p.cbegin(), p.cend());
-    _tmp_word2->replace(
-        _tmp_word2->begin(), _tmp_word2->end(), q.cbegin(), q.cend());
-    return test_equals(_tmp_word1, _tmp_word2);
+    _tmp_word1.assign(p);
+    _tmp_word2.assign(q);
+    return test_equals(&_tmp_word1, &_tmp_word2);
+  }
+
+  std::vector<bool> RWS::test_equals(std::vector<relation_t> const& pairs) {
+    knuth_bendix();
+    std::vector<bool> result(pairs.size());
+    batch(pairs.size(), [this, &pairs, &result](size_t first, size_t last) {
+      rws_word_t p;
+      rws_word_t q;
+      for (size_t i = first; i < last; ++i) {
+        word_to_rws_word(pairs[i].first, &p);
+        word_to_rws_word(pairs[i].second, &q);
+        if (p != q) {
+          internal_rewrite(&p);
+          internal_rewrite(&q);
+        }
+        result[i] = (p == q);
+      }
+    });
+    return result;
+  }
+
+  std::vector<bool> RWS::test_equals(std::vector<std::string>* p,
+                                     std::vector<std::string>* q) {
+    LIBSEMIGROUPS_ASSERT(p->size() == q->size());
+    knuth_bendix();
+    std::vector<bool> result(p->size());
+    batch(p->size(), [this, p, q, &result](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        std::string& u = (*p)[i];
+        std::string& v = (*q)[i];
+        if (u != v) {
+          string_to_rws_word(u);
+          internal_rewrite(&u);
+          rws_word_to_string(u);
+          string_to_rws_word(v);
+          internal_rewrite(&v);
+          rws_word_to_string(v);
+        }
+        result[i] = (u == v);
+      }
+    });
+    return result;
   }
 
   // Main method
@@ -702,16 +1482,22 @@ namespace libsemigroups {
   }
 
   bool RWS::test_less_than(word_t const& p, word_t const& q) {
-    return test_less_than(word_to_rws_word(p, _tmp_word1),
-                          word_to_rws_word(q, _tmp_word2));
+    // See the comment in test_equals(word_t const&, word_t const&).
+    word_to_rws_word(p, &_tmp_word1);
+    word_to_rws_word(q, &_tmp_word2);
+    if (_tmp_word1 == _tmp_word2) {
+      return false;
+    }
+    knuth_bendix();
+    internal_rewrite(&_tmp_word1);
+    internal_rewrite(&_tmp_word2);
+    return (*_order)(&_tmp_word2, &_tmp_word1);
   }
 
   bool RWS::test_less_than(std::string const& p, std::string const& q) {
-    _tmp_word1->replace(
-        _tmp_word1->begin(), _tmp_word1->end(), p.cbegin(), p.cend());
-    _tmp_word2->replace(
-        _tmp_word2->begin(), _tmp_word2->end(), q.cbegin(), q.cend());
-    return test_less_than(_tmp_word1, _tmp_word2);
+    _tmp_word1.assign(p);
+    _tmp_word2.assign(q);
+    return test_less_than(&_tmp_word1, &_tmp_word2);
   }
 
 }  // namespace libsemigroups
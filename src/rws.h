@@ -19,15 +19,19 @@
 #ifndef LIBSEMIGROUPS_SRC_RWS_H_
 #define LIBSEMIGROUPS_SRC_RWS_H_
 
+#include <algorithm>
 #include <atomic>
+#include <functional>
 #include <list>
-#include <set>
+#include <queue>
 #include <stack>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "cong.h"
+#include "recvec.h"
 #include "semigroups.h"
 
 namespace libsemigroups {
@@ -81,26 +85,26 @@ namespace libsemigroups {
           }) {}
   };
 
-  // The ordering used here is recursive path ordering (based on
-  // that described in the book "Confluent String Rewriting" by Matthias
-  // Jantzen, Defn 1.2.14, page 24).
-  //
-  // The ordering is as follows:
-  // let u, v be elements of X* u >= v iff one of the following conditions is
-  // fulfilled;
-  // 1) u = v
-  // OR
-  // u = u'a, v = v'b for some a,b elements of X, u',v' elements of X* and then:
-  // 2) a = b and u' >= v'
-  // OR
-  // 3) a > b and u  > v'
-  // OR
-  // 4) b > a and u'> v
-  //
-  // 1 or 0 = false
-  // 2      = true
-  /*class RECURSIVE : public ReductionOrdering {
+  //! This class implements the recursive path reduction ordering derived
+  //! from an ordering on libsemigroups::rws_letter_t's given by the operator
+  //! <.
+  //!
+  //! This ordering is described in the book "Confluent String Rewriting" by
+  //! Matthias Jantzen, Definition 1.2.14, page 24. If \f$u, v\f$ are words
+  //! and \f$a, b\f$ are letters, then \f$u \succ \varepsilon\f$ for every
+  //! non-empty word \f$u\f$, and \f$ua \succ vb\f$ if and only if one of
+  //! the following holds:
+  //! * \f$u = vb\f$ or \f$u \succ vb\f$;
+  //! * \f$a > b\f$ and \f$ua \succ v\f$;
+  //! * \f$a = b\f$ and \f$u \succ v\f$.
+  //!
+  //! Unlike SHORTLEX, a rule can have a right hand side which is longer
+  //! than its left hand side, and some rewriting systems are only confluent
+  //! with respect to this ordering.
+  class RECURSIVE : public ReductionOrdering {
    public:
+    //! Constructs a recursive path reduction ordering object derived from the
+    //! order of on libsemigroups::rws_letter_t's given by the operator <.
     RECURSIVE()
         : ReductionOrdering([](std::string const* Q, std::string const* P) {
             bool lastmoved = false;
@@ -124,7 +128,7 @@ namespace libsemigroups {
               }
             }
           }) {}
-  };*/
+  };
 
   // TODO add more reduction orderings
 
@@ -135,9 +139,9 @@ namespace libsemigroups {
   class RWS {
     // Forward declarations
     struct Rule;
-    class RuleLookup;
     struct OverlapMeasure;
     friend Rule;
+    friend class RWSE;
 
    public:
     //! Type for letters for rewriting systems.
@@ -165,33 +169,49 @@ namespace libsemigroups {
     explicit RWS(ReductionOrdering* order,
                  std::string        alphabet = STANDARD_ALPHABET)
         : _active_rules(),
+          _active_rules_bytes(0),
           _alphabet(alphabet),
           _check_confluence_interval(4096),
           // _clear_stack_interval(0),
           _confluence_known(false),
+          _deferred(),
           _inactive_rules(),
           _confluent(false),
+          _letters(),
+          _max_length_lhs_rule(0),
+          _max_memory(UNBOUNDED),
           _max_overlap(UNBOUNDED),
           _max_rules(UNBOUNDED),
+          _max_threads(1),
           _min_length_lhs_rule(std::numeric_limits<size_t>::max()),
+          _nf_automaton(0, 0, RuleTrie::UNDEFINED),
+          _nf_depth(),
+          _nf_nr_paths(),
+          _nf_valid(false),
+          _nr_deferred(0),
           _order(order),
           _overlap_measure(nullptr),
           _report_next(0),
           _report_interval(1000),
+          _rule_trie(),
+          _rules_version(0),
           _stack(),
-          _tmp_word1(new rws_word_t()),
-          _tmp_word2(new rws_word_t()),
+          _tmp_word1(),
+          _tmp_word2(),
           _total_rules(0) {
-      _next_rule_it1 = _active_rules.end();  // null
-      _next_rule_it2 = _active_rules.end();  // null
+      _next_rule_it1     = _active_rules.end();  // null
+      _next_rule_it2     = _active_rules.end();  // null
+      _unchecked_rule_it = _active_rules.end();  // null
       set_overlap_measure(overlap_measure::ABC);
       if (_alphabet != STANDARD_ALPHABET) {
         if (std::is_sorted(_alphabet.cbegin(), _alphabet.cend())) {
+          _letters  = _alphabet;
           _alphabet = STANDARD_ALPHABET;
         } else {
           for (size_t i = 0; i < _alphabet.size(); ++i) {
             _alphabet_map.emplace(
                 std::make_pair(_alphabet[i], uint_to_rws_letter(i)));
+            _letters += uint_to_rws_letter(i);
           }
         }
       }
@@ -282,6 +302,17 @@ namespace libsemigroups {
       return w;
     }
 
+    //! Rewrites every word in \p words in-place according to the current
+    //! rules in the rewriting system.
+    //!
+    //! The words are rewritten concurrently using up to the number of threads
+    //! set by RWS::set_max_threads, and the rules are not modified, so this
+    //! is most useful when the system is confluent. Rewriting a word of
+    //! fewer than 64 letters allocates no memory, unless the word grows
+    //! beyond its capacity; rewriting a longer word allocates a buffer of
+    //! nodes of the rule trie proportional to its length.
+    void rewrite(std::vector<std::string>* words) const;
+
     //! Run the [Knuth-Bendix
     //! algorithm](https://en.wikipedia.org/wiki/Knuth–Bendix_completion_algorithm)
     //! on the rewriting system.
@@ -365,6 +396,54 @@ namespace libsemigroups {
     //! the first entry.
     std::vector<std::pair<std::string, std::string>> rules() const;
 
+    //! Returns \c true if the word \p w contains no left hand side of an
+    //! active rule of the rewriting system as a subword, and \c false if not.
+    //!
+    //! If the system is confluent, then this is \c true if and only if \p w
+    //! is the normal form of the element it represents. The cost of this
+    //! method is linear in the length of \p w and does not depend on the
+    //! number of rules.
+    bool is_reduced(std::string const& w) const;
+
+    //! Returns the number of normal forms whose length is at least \p min
+    //! and less than \p max.
+    //!
+    //! The normal forms are the words over the alphabet of the rewriting
+    //! system which are irreducible with respect to its rules. This alphabet
+    //! is the one used to construct the rewriting system, or if none was
+    //! given, the letters occurring in the rules added to the system. The
+    //! normal forms are counted using an automaton which accepts them,
+    //! without rewriting or storing any words. For example, \c
+    //! nr_normal_forms(0, RWS::UNBOUNDED) is the size of the monoid defined
+    //! by the rewriting system, where the empty word is the normal form of
+    //! the identity.
+    //!
+    //! If \p max is RWS::UNBOUNDED and there are infinitely many normal forms
+    //! of length at least \p min, then RWS::UNBOUNDED is returned.
+    //!
+    //! \warning This method calls RWS::knuth_bendix and so it may never
+    //! terminate. If the system is not confluent when RWS::knuth_bendix
+    //! returns, for example, if RWS::set_max_rules was used, then the words
+    //! counted are only irreducible and not necessarily normal forms.
+    size_t nr_normal_forms(size_t min, size_t max);
+
+    //! Calls \p hook with every normal form whose length is at least \p min
+    //! and less than \p max, in short-lex order with respect to the order of
+    //! the letters in the alphabet, until \p hook returns \c false.
+    //!
+    //! The normal forms are those counted by RWS::nr_normal_forms, and they
+    //! are produced one at a time, rather than stored, at a cost of at most
+    //! the length of the normal form multiplied by the number of letters in
+    //! the alphabet for each normal form.
+    //!
+    //! \warning This method calls RWS::knuth_bendix and so it may never
+    //! terminate. If \p max is RWS::UNBOUNDED and there are infinitely many
+    //! normal forms, then this method only terminates if \p hook returns
+    //! \c false.
+    void normal_forms(size_t                                   min,
+                      size_t                                   max,
+                      std::function<bool(std::string const&)> hook);
+
     //! Turn reporting on or off.
     //!
     //! If \p val is true, then some methods for a RWS object may report
@@ -432,6 +511,53 @@ namespace libsemigroups {
       _max_rules = val;
     }
 
+    //! This method sets the (approximate) maximum number of bytes that
+    //! RWS::knuth_bendix should use for the active rules of the system, the
+    //! rules waiting to be added to it, and the overlaps which have not yet
+    //! been considered.
+    //!
+    //! If this number is exceeded, then RWS::knuth_bendix does not add the
+    //! rules arising from any further overlaps of left hand sides of rules.
+    //! Instead, these overlaps are stored, and are considered only after
+    //! all the other overlaps of the active rules, in increasing order of
+    //! their length (with respect to the RWS::overlap_measure), and for as
+    //! long as the number of bytes used is at most \p val. Unlike
+    //! RWS::set_max_rules, this does not stop RWS::knuth_bendix, but it
+    //! favours the short overlaps, whose rules tend to make other rules
+    //! redundant, once the system is large.
+    //!
+    //! The default value is RWS::UNBOUNDED.
+    //!
+    //! \sa RWS::knuth_bendix.
+    void set_max_memory(size_t val) {
+      _max_memory = val;
+    }
+
+    //! Set the maximum number of threads used by RWS::knuth_bendix.
+    //!
+    //! This also determines the number of threads used by the versions of
+    //! RWS::rewrite and RWS::test_equals for many words at once.
+    //!
+    //! If more than one thread is used, then RWS::knuth_bendix computes and
+    //! rewrites the overlaps of batches of rules concurrently, and then adds
+    //! the resulting rules to the system one at a time, except when the
+    //! limit set by RWS::set_max_memory is exceeded. The number of threads
+    //! is limited to the maximum of 1 and the minimum of \p nr_threads and the
+    //! number of threads supported by the hardware. The default value is 1.
+    //!
+    //! The same number of threads is used to check if the system is
+    //! confluent, see RWS::confluent and RWS::set_check_confluence_interval.
+    //!
+    //! If RWS::set_max_rules or RWS::set_max_overlap are used, then the rules
+    //! of the system when RWS::knuth_bendix terminates can depend on the
+    //! number of threads. A confluent system does not.
+    void set_max_threads(size_t nr_threads) {
+      unsigned int n
+          = static_cast<unsigned int>(nr_threads == 0 ? 1 : nr_threads);
+      _max_threads
+          = std::max(1U, std::min(n, std::thread::hardware_concurrency()));
+    }
+
     //! This method can be used to determine the way that the length of an
     //! overlap of two words in the system is meaasured.
     //!
@@ -513,6 +639,37 @@ namespace libsemigroups {
     //! \sa RWS::test_equals(word_t const& p, word_t const& q)
     bool test_equals(std::string* p, std::string* q);
 
+    //! Returns a std::vector<bool> whose entry in position \c i is \c true if
+    //! the reduced forms of \c RWS::word_to_rws_word applied to the words in
+    //! <tt>pairs[i]</tt> are equal, and \c false if not.
+    //!
+    //! The pairs are rewritten concurrently using up to the number of threads
+    //! set by RWS::set_max_threads. Every thread uses only two words for the
+    //! rewriting, and so memory is not allocated for every pair.
+    //!
+    //! \warning This method calls RWS::knuth_bendix and so it may never
+    //! terminate.
+    //!
+    //! \sa RWS::test_equals(word_t const& p, word_t const& q)
+    std::vector<bool> test_equals(std::vector<relation_t> const& pairs);
+
+    //! Returns a std::vector<bool> whose entry in position \c i is \c true if
+    //! \c RWS::rewrite(p[i]) equals \c RWS::rewrite(q[i]), and \c false if
+    //! not.
+    //!
+    //! This method rewrites the words in \p p and \p q in-place (unless
+    //! <tt>(*p)[i]</tt> and <tt>(*q)[i]</tt> are already equal before
+    //! rewriting, in which case neither is rewritten), using up to the number
+    //! of threads set by RWS::set_max_threads. The parameters \p p and \p q
+    //! must have the same size.
+    //!
+    //! \warning This method calls RWS::knuth_bendix and so it may never
+    //! terminate.
+    //!
+    //! \sa RWS::test_equals(std::string* p, std::string* q)
+    std::vector<bool> test_equals(std::vector<std::string>* p,
+                                  std::vector<std::string>* q);
+
     //! The constant value represents an UNBOUNDED quantity.
     //!
     //! \sa RWS::set_check_confluence_interval, RWS::set_max_rules,
@@ -610,12 +767,142 @@ namespace libsemigroups {
 
     static std::string const STANDARD_ALPHABET;
 
+    // Class for the trie of the left hand sides of the active rules of a RWS.
+    // The trie, together with its suffix links, is the Aho-Corasick automaton
+    // used by RWS::internal_rewrite to find the rules whose left hand sides
+    // are suffixes of the word read so far, at a cost per letter which does
+    // not depend on the number of rules.
+    //
+    // The suffix links, and the rule associated to every node, are computed
+    // lazily, and are recomputed when the rules in the trie change. Nodes are
+    // not removed when a rule is removed, instead the trie is rebuilt when
+    // there are sufficiently many unused nodes.
+    class RuleTrie {
+     public:
+      typedef size_t node_index_t;
+
+      // The root of the trie, corresponding to the empty word.
+      static node_index_t const ROOT = 0;
+
+      // A value which is not the index of any node.
+      static node_index_t const UNDEFINED;
+
+      RuleTrie();
+
+      // Adds <rule> to the trie, and returns true, unless there is another
+      // rule in the trie with the same left hand side, in which case this
+      // does nothing and returns false.
+      bool add_rule(Rule const* rule);
+
+      // Removes <rule>, which must belong to the trie, from the trie.
+      void remove_rule(Rule const* rule);
+
+      // Returns the number of nodes in the trie, some of which may not
+      // belong to the path of the left hand side of any rule.
+      size_t nr_nodes() const {
+        return _nodes.size();
+      }
+
+      // Returns the number of rules in the trie.
+      size_t nr_rules() const {
+        return _nr_rules;
+      }
+
+      // Returns the node corresponding to the longest suffix of the word of
+      // <node> followed by <a> which is a prefix of the left hand side of a
+      // rule in the trie.
+      node_index_t next_node(node_index_t node, rws_letter_t a) const;
+
+      // Returns the rule in the trie with the longest left hand side which is
+      // a suffix of the word of <node>, or nullptr if there is no such rule.
+      Rule const* rule(node_index_t node) const;
+
+      // Computes the suffix link and rule of every node, after which the
+      // const methods of this do not modify it (until a rule is added or
+      // removed), and so can be called concurrently.
+      void compute_links() const;
+
+     private:
+      struct Node {
+        Node(node_index_t parent, size_t col)
+            : _col(col),
+              _link(ROOT),
+              _link_version(0),
+              _parent(parent),
+              _rule(nullptr),
+              _suffix_rule(nullptr),
+              _suffix_rule_version(0) {}
+
+        size_t               _col;
+        mutable node_index_t _link;
+        mutable size_t       _link_version;
+        node_index_t         _parent;
+        Rule const*          _rule;
+        mutable Rule const*  _suffix_rule;
+        mutable size_t       _suffix_rule_version;
+      };
+
+      node_index_t link(node_index_t node) const;
+      node_index_t traverse(node_index_t node, size_t col) const;
+      void         rebuild();
+
+      RecVec<node_index_t> _children;
+      std::vector<size_t>  _letter_to_col;
+      size_t               _link_version;
+      std::vector<Node>    _nodes;
+      size_t               _nr_rules;
+      size_t               _suffix_rule_version;
+      size_t               _total_length;
+      mutable bool         _valid;
+    };
+
+    // Computes the automaton, with states the nodes of _rule_trie which are
+    // not the left hand side of any rule, which accepts the words over
+    // _letters which are irreducible, see RWS::nr_normal_forms.
+    void init_normal_forms();
+
+    // An overlap of the left hand sides of the active rules _u and _v, whose
+    // critical pair has not yet been added to the system, because the limit
+    // set by RWS::set_max_memory was exceeded. The overlap starts in position
+    // _pos of the left hand side of _u, and _nr is the number of overlaps
+    // deferred before this one.
+    struct DeferredOverlap {
+      bool operator>(DeferredOverlap const& that) const {
+        return _measure > that._measure
+               || (_measure == that._measure && _nr > that._nr);
+      }
+
+      size_t      _measure;
+      size_t      _nr;
+      size_t      _pos;
+      Rule const* _u;
+      Rule const* _v;
+    };
+
+    // Returns the (approximate) number of bytes used by the active rules,
+    // the stack, and the deferred overlaps.
+    size_t memory_used() const;
+
+    // Adds the rule arising from the overlap of the left hand sides of <u>
+    // and <v> starting at <it> to the system.
+    void push_overlap(Rule const*                       u,
+                      Rule const*                       v,
+                      rws_word_t::const_iterator const& it,
+                      std::atomic<bool>&                killed);
+
+    // Adds the rules of deferred overlaps to the system, shortest first,
+    // until the limit set by RWS::set_max_memory is exceeded again (but at
+    // least one).
+    void resume_overlaps(std::atomic<bool>& killed);
+
+    static size_t rule_bytes(Rule const* rule);
+
+    void activate_rule(Rule* rule);
     void add_rule(Rule* rule);
     std::list<Rule const*>::iterator
     remove_rule(std::list<Rule const*>::iterator it);
 
     Rule* new_rule() const;
-    Rule* new_rule(rws_word_t* lhs, rws_word_t* rhs) const;
     Rule* new_rule(Rule const* rule) const;
     Rule* new_rule(rws_word_t::const_iterator begin_lhs,
                    rws_word_t::const_iterator end_lhs,
@@ -623,37 +910,113 @@ namespace libsemigroups {
                    rws_word_t::const_iterator end_rhs) const;
 
     // Rewrites the word pointed to by \p w in-place according to the current
-    // rules in the rewriting system.
-    void internal_rewrite(rws_word_t* w) const;
+    // rules in the rewriting system. If \p pos is not 0, then the prefix of
+    // \p w of length \p pos must be reduced, and the letters of this prefix
+    // are mostly not read.
+    void internal_rewrite(rws_word_t* w, size_t pos = 0) const;
+
+    // Calls <func>(first, last) for ranges [first, last) partitioning [0, n),
+    // concurrently using up to _max_threads threads. Every range, except
+    // possibly the last, has length a multiple of 64, so that the threads can
+    // write to distinct parts of the same std::vector<bool>.
+    void batch(size_t n, std::function<void(size_t, size_t)> func) const;
 
     bool confluent(std::atomic<bool>& killed) const;
+    bool resolves(Rule const*        rule1,
+                  Rule const*        rule2,
+                  rws_word_t&        word1,
+                  rws_word_t&        word2,
+                  std::atomic<bool>& killed) const {
+      return resolves(rule1, rule2, word1, word2, killed, killed);
+    }
+    // As above, but stops as soon as either <killed> or <failed> is true.
+    bool resolves(Rule const*              rule1,
+                  Rule const*              rule2,
+                  rws_word_t&              word1,
+                  rws_word_t&              word2,
+                  std::atomic<bool> const& killed,
+                  std::atomic<bool> const& failed) const;
+    void resolve_batch(std::vector<Rule const*> const& rules,
+                       size_t                          first,
+                       size_t                          last,
+                       size_t                          step,
+                       std::atomic<bool>&              killed,
+                       std::atomic<bool>&              failed) const;
     void clear_stack(std::atomic<bool>& killed);
     void push_stack(Rule* rule);
     void push_stack(Rule* rule, std::atomic<bool>& killed);
     void overlap(Rule const* u, Rule const* v, std::atomic<bool>& killed);
+
+    // Computes the overlaps of <u> and <v>, and appends those critical pairs
+    // which are distinct after rewriting to <pairs>. This does not modify
+    // the system and can be called concurrently.
+    void overlap(Rule const*                                     u,
+                 Rule const*                                     v,
+                 std::atomic<bool>&                              killed,
+                 std::vector<std::pair<rws_word_t, rws_word_t>>& pairs) const;
+
+    // Computes the overlaps of the pairs of rules in positions <first> to
+    // <last> (not inclusive) of the list of pairs of rules processed by
+    // RWS::knuth_bendix for the rules in positions <rule1> onwards of
+    // <rules>, see RWS::overlap_batch.
+    void overlaps(std::vector<Rule const*> const&                 rules,
+                  size_t                                          rule1,
+                  size_t                                          first,
+                  size_t                                          last,
+                  std::atomic<bool>&                              killed,
+                  std::vector<std::pair<rws_word_t, rws_word_t>>& pairs) const;
+
+    size_t overlap_batch(std::atomic<bool>& killed);
     std::list<Rule const*>                 _active_rules;
+    size_t                                 _active_rules_bytes;
     std::string                            _alphabet;
     std::unordered_map<char, rws_letter_t> _alphabet_map;
     size_t                                 _check_confluence_interval;
     // size_t                           _clear_stack_interval;
     mutable std::atomic<bool>        _confluence_known;
+    std::priority_queue<DeferredOverlap,
+                        std::vector<DeferredOverlap>,
+                        std::greater<DeferredOverlap>>
+                                     _deferred;
     mutable std::list<Rule*>         _inactive_rules;
     mutable std::atomic<bool>        _confluent;
+    rws_word_t                       _letters;
+    size_t                           _max_length_lhs_rule;
+    size_t                           _max_memory;
     size_t                           _max_overlap;
     size_t                           _max_rules;
+    size_t                           _max_threads;
     size_t                           _min_length_lhs_rule;
     std::list<Rule const*>::iterator _next_rule_it1;
     std::list<Rule const*>::iterator _next_rule_it2;
+    // _nf_automaton is the transition table of the automaton computed by
+    // RWS::init_normal_forms. The entry _nf_depth[s] is the length of the
+    // longest word labelling a path from the state s, or RWS::UNBOUNDED if
+    // there are arbitrarily long such words, and if _nf_depth[0] is not
+    // RWS::UNBOUNDED, then _nf_nr_paths[s] is the number of such words.
+    RecVec<size_t>                   _nf_automaton;
+    std::vector<size_t>              _nf_depth;
+    std::vector<size_t>              _nf_nr_paths;
+    bool                             _nf_valid;
+    size_t                           _nr_deferred;
     ReductionOrdering const*         _order;
     OverlapMeasure*                  _overlap_measure;
     size_t                           _report_next;
     size_t                           _report_interval;
-    std::set<RuleLookup>             _set_rules;
+    RuleTrie                         _rule_trie;
+    // _rules_version is incremented whenever a rule is activated, so that a
+    // word which is reduced with respect to the rules when _rules_version
+    // has some value, remains reduced while it has the same value.
+    size_t                           _rules_version;
     std::stack<Rule*>                _stack;
-    rws_word_t*                      _tmp_word1;
-    rws_word_t*                      _tmp_word2;
+    rws_word_t                       _tmp_word1;
+    rws_word_t                       _tmp_word2;
     mutable size_t                   _total_rules;
 
+    // The overlaps of the active rules before _unchecked_rule_it with each
+    // other are known to resolve, see RWS::confluent.
+    mutable std::list<Rule const*>::iterator _unchecked_rule_it;
+
 #ifdef LIBSEMIGROUPS_STATS
     size_t                         max_active_word_length();
     size_t                         _max_stack_depth;
@@ -684,14 +1047,14 @@ namespace libsemigroups {
     // greater than its right hand side according to the reduction ordering of
     // the RWS used to construct this.
     rws_word_t const* lhs() const {
-      return const_cast<rws_word_t const*>(_lhs);
+      return &_lhs;
     }
 
     // Returns the right hand side of the rule, which is guaranteed to be
     // less than its left hand side according to the reduction ordering of
     // the RWS used to construct this.
     rws_word_t const* rhs() const {
-      return const_cast<rws_word_t const*>(_rhs);
+      return &_rhs;
     }
 
     // The Rule class does not support an assignment contructor to avoid
@@ -702,37 +1065,31 @@ namespace libsemigroups {
     // accidental copying.
     Rule(Rule const& copy) = delete;
 
-    // Construct from RWS with new but empty rws_word_t's
+    // Construct from RWS with empty rws_word_t's. The words are stored in the
+    // rule, rather than allocated separately, so that short words do not
+    // require any allocation, and the words of rules which are reused by
+    // RWS::new_rule keep their capacity.
     explicit Rule(RWS const* rws, int64_t id)
-        : _rws(rws),
-          _lhs(new rws_word_t()),
-          _rhs(new rws_word_t()),
-          _id(-1 * id) {
+        : _rws(rws), _lhs(), _rhs(), _id(-1 * id) {
       LIBSEMIGROUPS_ASSERT(_id < 0);
     }
 
-    // Destructor, deletes pointers used to create the rule.
-    ~Rule() {
-      delete _lhs;
-      delete _rhs;
-    }
-
     void rewrite() {
       LIBSEMIGROUPS_ASSERT(_id != 0);
-      _rws->internal_rewrite(_lhs);
-      _rws->internal_rewrite(_rhs);
+      _rws->internal_rewrite(&_lhs);
+      _rws->internal_rewrite(&_rhs);
       reorder();
     }
 
     void rewrite_rhs() {
       LIBSEMIGROUPS_ASSERT(_id != 0);
-      _rws->internal_rewrite(_rhs);
+      _rws->internal_rewrite(&_rhs);
     }
 
     void clear() {
       LIBSEMIGROUPS_ASSERT(_id != 0);
-      _lhs->clear();
-      _rhs->clear();
+      _lhs.clear();
+      _rhs.clear();
     }
 
     inline bool active() const {
@@ -766,57 +1123,15 @@ namespace libsemigroups {
     }
 
     void reorder() {
-      if ((*(_rws->_order))(_rhs, _lhs)) {
-        std::swap(_lhs, _rhs);
-      }
-    }
-
-    RWS const*  _rws;
-    rws_word_t* _lhs;
-    rws_word_t* _rhs;
-    int64_t     _id;
-  };
-
-  // Simple class wrapping a two iterators to an rws_word_t and a Rule const*
-  class RWS::RuleLookup {
-   public:
-    RuleLookup() : _rule(nullptr) {}
-
-    explicit RuleLookup(RWS::Rule* rule)
-        : _first(rule->lhs()->cbegin()),
-          _last(rule->lhs()->cend()),
-          _rule(rule) {}
-
-    RuleLookup& operator()(rws_word_t::iterator const& first,
-                           rws_word_t::iterator const& last) {
-      _first = first;
-      _last  = last;
-      return *this;
-    }
-
-    Rule const* rule() const {
-      return _rule;
-    }
-
-    // This implements reverse lex comparison of this and that, which satisfies
-    // the requirement of std::set that equivalent items be incomparable, so,
-    // for example bcbc and abcbc are considered equivalent, but abcba and bcbc
-    // are not.
-    bool operator<(RuleLookup const& that) const {
-      auto it_this = _last - 1;
-      auto it_that = that._last - 1;
-      while (it_this > _first && it_that > that._first
-             && *it_this == *it_that) {
-        --it_that;
-        --it_this;
+      if ((*(_rws->_order))(&_rhs, &_lhs)) {
+        _lhs.swap(_rhs);
       }
-      return *it_this < *it_that;
     }
 
-   private:
-    rws_word_t::const_iterator _first;
-    rws_word_t::const_iterator _last;
-    Rule const*                _rule;
+    RWS const* _rws;
+    rws_word_t _lhs;
+    rws_word_t _rhs;
+    int64_t    _id;
   };
 }  // namespace libsemigroups
 #endif  // LIBSEMIGROUPS_SRC_RWS_H_
@@ -33,8 +33,8 @@ namespace libsemigroups {
   bool RWSE::operator<(Element const& that) const {
     LIBSEMIGROUPS_ASSERT(_rws_word != nullptr);
     LIBSEMIGROUPS_ASSERT(static_cast<RWSE const&>(that)._rws_word != nullptr);
-    rws_word_t u = *(this->_rws_word);
-    rws_word_t v = *(static_cast<RWSE const&>(that)._rws_word);
+    rws_word_t const& u = *(this->_rws_word);
+    rws_word_t const& v = *(static_cast<RWSE const&>(that)._rws_word);
     if (u != v && (u.size() < v.size() || (u.size() == v.size() && u < v))) {
       // TODO allow other reduction orders here
       return true;
@@ -48,7 +48,7 @@ namespace libsemigroups {
     LIBSEMIGROUPS_ASSERT(_rws_word != nullptr);
     (void) increase_deg_by;  // to keep the compiler happy
     rws_word_t* rws_word(new rws_word_t(*(this->_rws_word)));
-    return new RWSE(_rws, rws_word, false);
+    return new RWSE(_rws, rws_word, false, _rules_version);
   }
 
   void RWSE::copy(Element const* x) {
@@ -56,6 +56,7 @@ namespace libsemigroups {
     RWSE const* xx(static_cast<RWSE const*>(x));
     LIBSEMIGROUPS_ASSERT(xx->_rws_word != nullptr);
     _rws_word->assign(xx->_rws_word->cbegin(), xx->_rws_word->cend());
+    _rules_version = xx->_rules_version;
     reset_hash_value();
   }
 
@@ -64,6 +65,7 @@ namespace libsemigroups {
     RWSE* xx = static_cast<RWSE*>(x);
     LIBSEMIGROUPS_ASSERT(xx->_rws_word != nullptr);
     _rws_word->swap(*(xx->_rws_word));
+    std::swap(_rules_version, xx->_rules_version);
     std::swap(this->_hash_value, xx->_hash_value);
   }
 
@@ -78,7 +80,14 @@ namespace libsemigroups {
     _rws_word->clear();
     _rws_word->append(*(xx->_rws_word));
     _rws_word->append(*(yy->_rws_word));
-    _rws->rewrite(_rws_word);
+    if (xx->_rules_version == _rws->_rules_version) {
+      // xx is reduced, and so only the letters near the end of xx, and those
+      // of yy, have to be read.
+      _rws->internal_rewrite(_rws_word, xx->_rws_word->size());
+    } else {
+      _rws->internal_rewrite(_rws_word);
+    }
+    _rules_version = _rws->_rules_version;
     this->reset_hash_value();
   }
 }  // namespace libsemigroups
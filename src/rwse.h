@@ -40,10 +40,14 @@ namespace libsemigroups {
     using rws_word_t              = RWS::rws_word_t;
 
    private:
-    RWSE(RWS* rws, rws_word_t* w, bool reduce)
-        : Element(), _rws(rws), _rws_word(w) {
+    RWSE(RWS* rws, rws_word_t* w, bool reduce, size_t rules_version)
+        : Element(),
+          _rws(rws),
+          _rws_word(w),
+          _rules_version(rules_version) {
       if (reduce) {
-        _rws->rewrite(_rws_word);
+        _rws->internal_rewrite(_rws_word);
+        _rules_version = _rws->_rules_version;
       }
     }
 
@@ -59,7 +63,7 @@ namespace libsemigroups {
     //!
     //! The rewriting system \p rws is not copied either, and it is the
     //! responsibility of the caller to delete it.
-    RWSE(RWS* rws, rws_word_t* w) : RWSE(rws, w, true) {
+    RWSE(RWS* rws, rws_word_t* w) : RWSE(rws, w, true, 0) {
       LIBSEMIGROUPS_ASSERT(w != nullptr);
     }
 
@@ -171,6 +175,11 @@ namespace libsemigroups {
     //! \p x and \p y. This method asserts that \p x and \p y have the same
     //! rewriting system.
     //!
+    //! If no rules have been added to the rewriting system since \p x was
+    //! reduced, then only the last few letters of \p x are read, since every
+    //! left hand side of a rule occurring in the concatenation must overlap
+    //! \p y.
+    //!
     //! The parameter \p thread_id is required since some temporary storage is
     //! required to find the product of \p x and \p y.  Note that if different
     //! threads call this method with the same value of \p thread_id then bad
@@ -196,6 +205,8 @@ namespace libsemigroups {
     // TODO const!
     RWS*        _rws;
     rws_word_t* _rws_word;
+    // The value of RWS::_rules_version when _rws_word was last reduced
+    size_t _rules_version;
   };
 }  // namespace libsemigroups
 
@@ -1263,6 +1263,12 @@ namespace libsemigroups {
     //! are the only new elements, unlike, say, in the case of non-trivial
     //! groups.
     //!
+    //! The degree of the elements in \p coll can be greater than
+    //! Semigroup::degree, in which case the degree of every existing element
+    //! of the semigroup is increased in-place using
+    //! Element::increase_degree_by before the new generators are added. No
+    //! elements are copied, unlike in Semigroup::copy_add_generators.
+    //!
     //! The elements the argument \p coll are copied into the semigroup, and
     //! should be deleted by the caller.
     void add_generators(std::vector<TElementType>* coll) {
@@ -1272,7 +1278,11 @@ namespace libsemigroups {
       Timer  timer;
       size_t tid = glob_reporter.thread_id(std::this_thread::get_id());
 
-      LIBSEMIGROUPS_ASSERT(degree() == this->element_degree(*coll->begin()));
+      LIBSEMIGROUPS_ASSERT(degree() <= this->element_degree(*coll->begin()));
+      if (degree() < this->element_degree(*coll->begin())) {
+        increase_degree_in_place(this->element_degree(*coll->begin())
+                                 - degree());
+      }
 
       // get some parameters from the old semigroup
       letter_t old_nrgens  = _nrgens;
@@ -1467,6 +1477,11 @@ namespace libsemigroups {
     //! the parts of \c this that are immediately invalidated by
     //! Semigroup::add_generators.
     //!
+    //! Every element of \c this is copied, with its degree increased if the
+    //! degree of the elements in \p coll is greater than Semigroup::degree.
+    //! If \c this is not required afterwards, then calling
+    //! Semigroup::add_generators on \c this uses less memory.
+    //!
     //! The elements the argument \p coll are copied into the semigroup, and
     //! should be deleted by the caller.
     Semigroup* copy_add_generators(std::vector<TElementType>* coll) const {
@@ -1539,6 +1554,10 @@ namespace libsemigroups {
     //! copying the parts of \c this that are immediately invalidated by
     //! Semigroup::closure.
     //!
+    //! As for Semigroup::copy_add_generators, if \c this is not required
+    //! afterwards, then calling Semigroup::closure on \c this uses less
+    //! memory.
+    //!
     //! The elements the argument \p coll are copied into the semigroup, and
     //! should be deleted by the caller.
     Semigroup* copy_closure(std::vector<TElementType>* coll) {
@@ -1895,6 +1914,35 @@ namespace libsemigroups {
       }
     }
 
+    // Increases the degree of every element of this by deg_plus in-place, so
+    // that generators of the larger degree can be added by add_generators.
+    // Unlike the partial copy constructor, this does not copy any elements,
+    // but since their hash values change, _map is rebuilt.
+    void increase_degree_in_place(size_t deg_plus) {
+      LIBSEMIGROUPS_ASSERT(deg_plus != 0);
+      _degree += deg_plus;
+      for (TElementType x : _elements) {
+        this->increase_degree_by(x, deg_plus);
+      }
+      // the non-duplicate gens are in _elements, and so have already been
+      // changed
+      for (auto const& x : _duplicate_gens) {
+        this->increase_degree_by(_gens[x.first], deg_plus);
+      }
+      this->increase_degree_by(_tmp_product, deg_plus);
+      this->free(_id);
+      _id = this->one(_tmp_product);
+
+      _map.clear();
+      _found_one = false;
+      _pos_one   = 0;
+      for (element_index_t i = 0; i < _nr; i++) {
+        _map.insert(std::make_pair(_elements[i], i));
+        is_one(_elements[i], i);
+      }
+      _sorted.clear();
+    }
+
     // _nrgens, _duplicates_gens, _letter_to_pos, and _elements must all be
     // initialised for this to work, and _gens must point to an empty vector.
     void copy_gens() {
@@ -23,11 +23,41 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <vector>
 
 #include "libsemigroups-debug.h"
 
 namespace libsemigroups {
 
+  // Multiplies the n x n matrices x and y, whose entries are stored row by
+  // row, over the semiring with additive identity zero and operations plus
+  // and prod, and stores the result in xy, which must not be x or y. The
+  // entries of xy are accumulated a row at a time, so that the innermost
+  // loop runs over contiguous entries of y and xy. If plus and prod can be
+  // inlined, then this loop can be vectorised by the compiler.
+  template <typename T, typename TPlus, typename TProd>
+  inline void matrix_product(std::vector<T> const& x,
+                             std::vector<T> const& y,
+                             std::vector<T>&       xy,
+                             size_t const          n,
+                             T const               zero,
+                             TPlus const&          plus,
+                             TProd const&          prod) {
+    LIBSEMIGROUPS_ASSERT(&x != &xy && &y != &xy);
+    for (size_t i = 0; i < n; i++) {
+      std::fill(xy.begin() + i * n, xy.begin() + (i + 1) * n, zero);
+      for (size_t k = 0; k < n; k++) {
+        T const      a     = x[i * n + k];
+        size_t const y_row = k * n;
+        size_t const row   = i * n;
+        for (size_t j = 0; j < n; j++) {
+          xy[row + j] = plus(xy[row + j], prod(a, y[y_row + j]));
+        }
+      }
+    }
+  }
+
   //! This class its subclasses provide very basic functionality for creating
   //! semirings.
   //!
@@ -70,6 +100,28 @@ namespace libsemigroups {
 
     //! Returns the product of \p x and \p y.
     virtual T prod(T x, T y) const = 0;
+
+    //! Multiplies the matrices \p x and \p y and stores the result in \p xy.
+    //!
+    //! The parameters \p x, \p y, and \p xy should be vectors of length
+    //! \f$n ^ 2\f$ containing the entries of \f$n\times n\f$ matrices row
+    //! by row, and \p xy must not be \p x or \p y. This method is used by
+    //! MatrixOverSemiring::redefine. The implementation in this class calls
+    //! Semiring::plus and Semiring::prod for every pair of entries, and
+    //! derived classes override it so that their operations can be inlined.
+    virtual void matrix_product(std::vector<T> const& x,
+                                std::vector<T> const& y,
+                                std::vector<T>&       xy,
+                                size_t                n) const {
+      libsemigroups::matrix_product(
+          x,
+          y,
+          xy,
+          n,
+          zero(),
+          [this](T a, T b) { return plus(a, b); },
+          [this](T a, T b) { return prod(a, b); });
+    }
   };
 
   template <typename T>
@@ -107,10 +159,44 @@ namespace libsemigroups {
     }
   };
 
+  //! This class template provides an implementation of
+  //! Semiring::matrix_product for its subclass \p TSubclass.
+  //!
+  //! The methods \c zero, \c plus, and \c prod of \p TSubclass are called
+  //! non-virtually, so that they can be inlined in the innermost loop of the
+  //! product. Hence a subclass of \p TSubclass which overrides \c plus or
+  //! \c prod must also override \c matrix_product; the semirings in this file
+  //! which use this class template are \c final for this reason. The template
+  //! parameter \p TBase is the class that \p TSubclass would otherwise derive
+  //! from.
+  template <typename TSubclass, typename TBase = Semiring<int64_t>>
+  class SemiringWithMatrixProduct : public TBase {
+   public:
+    using TBase::TBase;
+
+    //! Multiplies the matrices \p x and \p y and stores the result in \p xy.
+    //!
+    //! See Semiring::matrix_product for details.
+    void matrix_product(std::vector<int64_t> const& x,
+                        std::vector<int64_t> const& y,
+                        std::vector<int64_t>&       xy,
+                        size_t                      n) const override {
+      TSubclass const* sr = static_cast<TSubclass const*>(this);
+      libsemigroups::matrix_product(
+          x,
+          y,
+          xy,
+          n,
+          sr->TSubclass::zero(),
+          [sr](int64_t a, int64_t b) { return sr->TSubclass::plus(a, b); },
+          [sr](int64_t a, int64_t b) { return sr->TSubclass::prod(a, b); });
+    }
+  };
+
   //! The usual ring of integers.
-  class Integers : public Semiring<int64_t> {
+  class Integers final : public SemiringWithMatrixProduct<Integers> {
    public:
-    Integers() : Semiring<int64_t>() {}
+    Integers() : SemiringWithMatrixProduct() {}
 
     //! Returns the integer 1.
     int64_t one() const override {
@@ -136,9 +222,10 @@ namespace libsemigroups {
   //! The *max-plus semiring* consists of the integers together with negative
   //! infinity with operations max and plus. Negative infinity is represented
   //! by Semiring<int64_t>::MINUS_INFTY.
-  class MaxPlusSemiring : public Semiring<int64_t> {
+  class MaxPlusSemiring final
+      : public SemiringWithMatrixProduct<MaxPlusSemiring> {
    public:
-    MaxPlusSemiring() : Semiring<int64_t>() {}
+    MaxPlusSemiring() : SemiringWithMatrixProduct() {}
 
     //! Returns the integer 0.
     int64_t one() const override {
@@ -168,9 +255,10 @@ namespace libsemigroups {
   //! The *min-plus semiring* consists of the integers together
   //! with infinity with operations min and plus. Infinity is represented by
   //! Semiring<int64_t>::INFTY.
-  class MinPlusSemiring : public Semiring<int64_t> {
+  class MinPlusSemiring final
+      : public SemiringWithMatrixProduct<MinPlusSemiring> {
    public:
-    MinPlusSemiring() : Semiring<int64_t>() {}
+    MinPlusSemiring() : SemiringWithMatrixProduct() {}
 
     //! Returns the integer 0.
     int64_t one() const override {
@@ -222,13 +310,15 @@ namespace libsemigroups {
   //! \f$\{0, \ldots , t\}\f$ for some value \f$t\f$ (called the
   //! **threshold** of the semiring) and \f$-\infty\f$. Negative infinity is
   //! represented by Semiring<int64_t>::MINUS_INFTY.
-  class TropicalMaxPlusSemiring : public SemiringWithThreshold {
+  class TropicalMaxPlusSemiring final
+      : public SemiringWithMatrixProduct<TropicalMaxPlusSemiring,
+                                         SemiringWithThreshold> {
    public:
     //! Construct from threshold.
     //!
     //! The threshold is the largest integer in the semiring.
     explicit TropicalMaxPlusSemiring(int64_t threshold)
-        : SemiringWithThreshold(threshold) {}
+        : SemiringWithMatrixProduct(threshold) {}
 
     // Returns the integer 0.
     int64_t one() const override {
@@ -270,13 +360,15 @@ namespace libsemigroups {
   //! \f$\{0, \ldots , t\}\f$ for some value \f$t\f$ (called the **threshold**
   //! of the semiring) and \f$\infty\f$. Infinity is represented
   //! by Semiring<int64_t>::INFTY.
-  class TropicalMinPlusSemiring : public SemiringWithThreshold {
+  class TropicalMinPlusSemiring final
+      : public SemiringWithMatrixProduct<TropicalMinPlusSemiring,
+                                         SemiringWithThreshold> {
    public:
     //! Construct from threshold.
     //!
     //! The threshold is the largest integer in the semiring.
     explicit TropicalMinPlusSemiring(int64_t threshold)
-        : SemiringWithThreshold(threshold) {}
+        : SemiringWithMatrixProduct(threshold) {}
 
     //! Returns the integer 0.
     int64_t one() const override {
@@ -321,7 +413,9 @@ namespace libsemigroups {
   //! \f$\{0, 1, ..., t, t +  1, ..., t + p - 1\}\f$ for some **threshold**
   //! \f$t\f$ and **period** \f$p\f$ with operations addition and
   //! multiplication modulo the congruence \f$t = t + p\f$.
-  class NaturalSemiring : public SemiringWithThreshold {
+  class NaturalSemiring final
+      : public SemiringWithMatrixProduct<NaturalSemiring,
+                                         SemiringWithThreshold> {
    public:
     //! Construct from threshold and period.
     //!
@@ -334,7 +428,7 @@ namespace libsemigroups {
     //! parameter \p p must be strictly greater than 0, both which are asserted
     //! in the constructor.
     NaturalSemiring(int64_t t, int64_t p)
-        : SemiringWithThreshold(t), _period(p) {
+        : SemiringWithMatrixProduct(t), _period(p) {
       LIBSEMIGROUPS_ASSERT(_period > 0);
       LIBSEMIGROUPS_ASSERT(this->threshold() >= 0);
     }
@@ -381,6 +475,225 @@ namespace libsemigroups {
 
     int64_t _period;
   };
+
+  // The following classes are semirings whose operations, and any threshold
+  // or period, are known at compile time. They are used as the template
+  // parameter of StaticMatrixOverSemiring, so that the operations can be
+  // inlined, rather than called through a pointer to a Semiring.
+
+  //! The usual ring of integers, with operations known at compile time.
+  //!
+  //! \sa Integers.
+  struct StaticIntegers {
+    //! The type of the elements of the semiring.
+    using value_type = int64_t;
+
+    //! Returns the integer 0.
+    static constexpr int64_t zero() {
+      return 0;
+    }
+
+    //! Returns the integer 1.
+    static constexpr int64_t one() {
+      return 1;
+    }
+
+    //! Returns the sum \f$x + y\f$.
+    static constexpr int64_t plus(int64_t x, int64_t y) {
+      return x + y;
+    }
+
+    //! Returns the product \f$xy\f$.
+    static constexpr int64_t prod(int64_t x, int64_t y) {
+      return x * y;
+    }
+  };
+
+  //! The max-plus semiring, with operations known at compile time.
+  //!
+  //! \sa MaxPlusSemiring.
+  struct StaticMaxPlusSemiring {
+    //! The type of the elements of the semiring.
+    using value_type = int64_t;
+
+    //! Returns Semiring<int64_t>::MINUS_INFTY.
+    static constexpr int64_t zero() {
+      return std::numeric_limits<int64_t>::min();
+    }
+
+    //! Returns the integer 0.
+    static constexpr int64_t one() {
+      return 0;
+    }
+
+    //! Returns the maximum of \p x and \p y.
+    static constexpr int64_t plus(int64_t x, int64_t y) {
+      return (x > y ? x : y);
+    }
+
+    //! Returns Semiring<int64_t>::MINUS_INFTY if \p x or \p y equals
+    //! Semiring<int64_t>::MINUS_INFTY, otherwise returns \p x + \p y.
+    static constexpr int64_t prod(int64_t x, int64_t y) {
+      return (x == zero() || y == zero() ? zero() : x + y);
+    }
+  };
+
+  //! The min-plus semiring, with operations known at compile time.
+  //!
+  //! \sa MinPlusSemiring.
+  struct StaticMinPlusSemiring {
+    //! The type of the elements of the semiring.
+    using value_type = int64_t;
+
+    //! Returns Semiring<int64_t>::INFTY.
+    static constexpr int64_t zero() {
+      return std::numeric_limits<int64_t>::max();
+    }
+
+    //! Returns the integer 0.
+    static constexpr int64_t one() {
+      return 0;
+    }
+
+    //! Returns the minimum of \p x and \p y.
+    static constexpr int64_t plus(int64_t x, int64_t y) {
+      return (x < y ? x : y);
+    }
+
+    //! Returns Semiring<int64_t>::INFTY if \p x or \p y equals
+    //! Semiring<int64_t>::INFTY, otherwise returns \p x + \p y.
+    static constexpr int64_t prod(int64_t x, int64_t y) {
+      return (x == zero() || y == zero() ? zero() : x + y);
+    }
+  };
+
+  //! The tropical max-plus semiring with threshold \p TThreshold, with
+  //! operations known at compile time.
+  //!
+  //! \sa TropicalMaxPlusSemiring.
+  template <int64_t TThreshold> struct StaticTropicalMaxPlusSemiring {
+    static_assert(TThreshold >= 0, "the threshold must be non-negative");
+
+    //! The type of the elements of the semiring.
+    using value_type = int64_t;
+
+    //! Returns the threshold of the semiring.
+    static constexpr int64_t threshold() {
+      return TThreshold;
+    }
+
+    //! Returns Semiring<int64_t>::MINUS_INFTY.
+    static constexpr int64_t zero() {
+      return std::numeric_limits<int64_t>::min();
+    }
+
+    //! Returns the integer 0.
+    static constexpr int64_t one() {
+      return 0;
+    }
+
+    //! Returns the maximum of \p x and \p y.
+    static constexpr int64_t plus(int64_t x, int64_t y) {
+      return (x > y ? x : y);
+    }
+
+    //! Returns Semiring<int64_t>::MINUS_INFTY if \p x or \p y equals
+    //! Semiring<int64_t>::MINUS_INFTY, otherwise returns the minimum of \p x
+    //! + \p y and the threshold of the semiring.
+    static constexpr int64_t prod(int64_t x, int64_t y) {
+      return (x == zero() || y == zero()
+                  ? zero()
+                  : (x + y < TThreshold ? x + y : TThreshold));
+    }
+  };
+
+  //! The tropical min-plus semiring with threshold \p TThreshold, with
+  //! operations known at compile time.
+  //!
+  //! \sa TropicalMinPlusSemiring.
+  template <int64_t TThreshold> struct StaticTropicalMinPlusSemiring {
+    static_assert(TThreshold >= 0, "the threshold must be non-negative");
+
+    //! The type of the elements of the semiring.
+    using value_type = int64_t;
+
+    //! Returns the threshold of the semiring.
+    static constexpr int64_t threshold() {
+      return TThreshold;
+    }
+
+    //! Returns Semiring<int64_t>::INFTY.
+    static constexpr int64_t zero() {
+      return std::numeric_limits<int64_t>::max();
+    }
+
+    //! Returns the integer 0.
+    static constexpr int64_t one() {
+      return 0;
+    }
+
+    //! Returns the minimum of \p x and \p y.
+    static constexpr int64_t plus(int64_t x, int64_t y) {
+      return (x < y ? x : y);
+    }
+
+    //! Returns Semiring<int64_t>::INFTY if \p x or \p y equals
+    //! Semiring<int64_t>::INFTY, otherwise return the minimum of \p x + \p y
+    //! and the threshold of the semiring.
+    static constexpr int64_t prod(int64_t x, int64_t y) {
+      return (x == zero() || y == zero()
+                  ? zero()
+                  : (x + y < TThreshold ? x + y : TThreshold));
+    }
+  };
+
+  //! The semiring \f$\{0, 1, \ldots, t + p - 1\}\f$ with threshold
+  //! \f$t\f$ equal to \p TThreshold and period \f$p\f$ equal to \p TPeriod,
+  //! with operations known at compile time.
+  //!
+  //! \sa NaturalSemiring.
+  template <int64_t TThreshold, int64_t TPeriod> struct StaticNaturalSemiring {
+    static_assert(TThreshold >= 0, "the threshold must be non-negative");
+    static_assert(TPeriod > 0, "the period must be positive");
+
+    //! The type of the elements of the semiring.
+    using value_type = int64_t;
+
+    //! Returns the threshold of the semiring.
+    static constexpr int64_t threshold() {
+      return TThreshold;
+    }
+
+    //! Returns the period of the semiring.
+    static constexpr int64_t period() {
+      return TPeriod;
+    }
+
+    //! Return the integer 0.
+    static constexpr int64_t zero() {
+      return 0;
+    }
+
+    //! Return the integer 1.
+    static constexpr int64_t one() {
+      return 1;
+    }
+
+    //! Returns \p x + \p y modulo the congruence \f$t = t + p\f$.
+    static constexpr int64_t plus(int64_t x, int64_t y) {
+      return thresholdperiod(x + y);
+    }
+
+    //! Returns \p x * \p y modulo the congruence \f$t = t + p\f$.
+    static constexpr int64_t prod(int64_t x, int64_t y) {
+      return thresholdperiod(x * y);
+    }
+
+   private:
+    static constexpr int64_t thresholdperiod(int64_t x) {
+      return (x > TThreshold ? TThreshold + (x - TThreshold) % TPeriod : x);
+    }
+  };
 }  // namespace libsemigroups
 
 #endif  // LIBSEMIGROUPS_SRC_SEMIRING_H_
@@ -0,0 +1,270 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains a declaration of fast bipartitions of bounded degree.
+
+#ifndef LIBSEMIGROUPS_SRC_SMALLBIPART_H_
+#define LIBSEMIGROUPS_SRC_SMALLBIPART_H_
+
+#include <string.h>
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "hash.h"
+#include "libsemigroups-debug.h"
+
+namespace libsemigroups {
+
+  //! Class for fast bipartitions of degree at most \p N.
+  //!
+  //! A SmallBipartition represents the same objects as a Bipartition of
+  //! degree at most \p N, which must be at most 64. The index of the block
+  //! containing every point is stored in an array of \f$2N\f$ bytes inside
+  //! the object, rather than in a vector on the heap, and the number of
+  //! blocks is always known. Hence a SmallBipartition can be multiplied,
+  //! copied, hashed, and compared without allocating any memory, and without
+  //! any temporary storage shared between threads. This makes
+  //! SmallBipartition suitable for use with Semigroup in the same way as
+  //! BMat8.
+  //!
+  //! SmallBipartition is a trivial class.
+  template <size_t N> class SmallBipartition {
+    static_assert(N > 0 && N <= 64,
+                  "the degree of a SmallBipartition must be at most 64");
+
+   public:
+    //! A default constructor.
+    //!
+    //! This constructor gives no guarantees on what the bipartition will
+    //! contain.
+    SmallBipartition() = default;
+
+    //! A constructor.
+    //!
+    //! The parameter \p blocks must be of the same form as the parameter of
+    //! Bipartition::Bipartition, i.e. it must have length \f$2n\f$ for some
+    //! non-negative integer \f$n\f$ at most \p N, and if \f$i > 0\f$ occurs
+    //! in \p blocks, then \f$i - 1\f$ occurs earlier in \p blocks. This is
+    //! only checked if \c LIBSEMIGROUPS_DEBUG is defined; otherwise any
+    //! entries of \p blocks after the first \f$2N\f$ are ignored.
+    explicit SmallBipartition(std::vector<u_int32_t> const& blocks)
+        : _nr_blocks(0) {
+      LIBSEMIGROUPS_ASSERT(blocks.size() % 2 == 0);
+      LIBSEMIGROUPS_ASSERT(blocks.size() <= 2 * N);
+      size_t const n = std::min(blocks.size(), 2 * N);
+      _degree        = n / 2;
+      for (size_t i = 0; i < n; i++) {
+        LIBSEMIGROUPS_ASSERT(blocks[i] <= _nr_blocks);
+        _blocks[i] = blocks[i];
+        if (blocks[i] == _nr_blocks) {
+          _nr_blocks++;
+        }
+      }
+    }
+
+    //! A constructor.
+    //!
+    //! This is the copy constructor.
+    SmallBipartition(SmallBipartition const&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the move constructor.
+    SmallBipartition(SmallBipartition&&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the copy assignement constructor.
+    SmallBipartition& operator=(SmallBipartition const&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the move assignment  constructor.
+    SmallBipartition& operator=(SmallBipartition&&) = default;
+
+    //! A default destructor.
+    ~SmallBipartition() = default;
+
+    //! Returns \c true if \c this equals \p that.
+    //!
+    //! This method checks the mathematical equality of two SmallBipartition
+    //! objects.
+    bool operator==(SmallBipartition const& that) const {
+      return _degree == that._degree && _nr_blocks == that._nr_blocks
+             && memcmp(_blocks, that._blocks, 2 * _degree) == 0;
+    }
+
+    //! Returns \c true if \c this does not equal \p that.
+    //!
+    //! This method checks the mathematical inequality of two SmallBipartition
+    //! objects.
+    bool operator!=(SmallBipartition const& that) const {
+      return !(*this == that);
+    }
+
+    //! Returns \c true if \c this is less than \p that.
+    //!
+    //! A SmallBipartition is less than another if it has smaller degree, or
+    //! if they have the same degree and its blocks are lexicographically
+    //! smaller, which is the same order as for Bipartition.
+    bool operator<(SmallBipartition const& that) const {
+      if (_degree != that._degree) {
+        return _degree < that._degree;
+      }
+      return memcmp(_blocks, that._blocks, 2 * _degree) < 0;
+    }
+
+    //! Returns the index of the block containing \p i.
+    //!
+    //! This method asserts that \p i is less than twice the degree.
+    inline u_int32_t operator[](size_t i) const {
+      LIBSEMIGROUPS_ASSERT(i < 2 * _degree);
+      return _blocks[i];
+    }
+
+    //! Returns the degree of \c this.
+    //!
+    //! A bipartition is of degree \f$n\f$ if it is a partition of
+    //! \f$\{0, \ldots, 2n - 1\}\f$.
+    inline size_t degree() const {
+      return _degree;
+    }
+
+    //! Returns the number of blocks of \c this.
+    inline size_t nr_blocks() const {
+      return _nr_blocks;
+    }
+
+    //! Returns a hash value for \c this.
+    //!
+    //! Unless libsemigroups is configured with \c --disable-mixhash, this
+    //! method uses hash_bytes.
+    inline size_t hash_value() const {
+#ifdef LIBSEMIGROUPS_USE_MIXHASH
+      return hash_bytes(_blocks, 2 * _degree);
+#else
+      size_t seed = 0;
+      for (size_t i = 0; i < 2 * _degree; i++) {
+        seed ^= _blocks[i] + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+#endif
+    }
+
+    //! Returns the product of \c this and \p that.
+    //!
+    //! This method asserts that the degrees of \c this and \p that are equal.
+    //! The blocks of \c this and \p that are fused using a union-find table
+    //! which is stored on the stack.
+    SmallBipartition operator*(SmallBipartition const& that) const {
+      LIBSEMIGROUPS_ASSERT(_degree == that._degree);
+      size_t const n   = _degree;
+      size_t const nrx = _nr_blocks;
+
+      // The blocks of that are numbered from nrx in fuse, and there are at
+      // most 2N blocks in each of this and that.
+      u_int8_t fuse[4 * N];
+      u_int8_t lookup[4 * N];
+      for (size_t i = 0; i < nrx + that._nr_blocks; i++) {
+        fuse[i]   = i;
+        lookup[i] = UNDEFINED;
+      }
+
+      for (size_t i = 0; i < n; i++) {
+        size_t const j = find(fuse, _blocks[i + n]);
+        size_t const k = find(fuse, that._blocks[i] + nrx);
+        fuse[std::max(j, k)] = std::min(j, k);
+      }
+
+      SmallBipartition xy;
+      xy._degree    = n;
+      xy._nr_blocks = 0;
+      for (size_t i = 0; i < 2 * n; i++) {
+        size_t const j = (i < n ? find(fuse, _blocks[i])
+                                : find(fuse, that._blocks[i] + nrx));
+        if (lookup[j] == UNDEFINED) {
+          lookup[j] = xy._nr_blocks++;
+        }
+        xy._blocks[i] = lookup[j];
+      }
+      return xy;
+    }
+
+    //! Returns the identity SmallBipartition.
+    //!
+    //! This method returns the identity bipartition of degree equal to that
+    //! of \c this, whose blocks are \f$\{i, i + n\}\f$ for all \f$i\f$ less
+    //! than the degree \f$n\f$.
+    SmallBipartition one() const {
+      // The degree is at most N, and n makes this visible to the compiler.
+      size_t const     n = std::min(static_cast<size_t>(_degree), N);
+      SmallBipartition id;
+      id._degree    = n;
+      id._nr_blocks = n;
+      for (size_t i = 0; i < n; i++) {
+        id._blocks[i]     = i;
+        id._blocks[i + n] = i;
+      }
+      return id;
+    }
+
+#if defined(LIBSEMIGROUPS_HAVE_DENSEHASHMAP) \
+    && defined(LIBSEMIGROUPS_USE_DENSEHASHMAP)
+    //! Returns the empty key for google's dense_hash_map.
+    //!
+    //! The returned object has degree 0 and 255 blocks, and so it is not
+    //! equal to any bipartition.
+    SmallBipartition empty_key() const {
+      SmallBipartition key;
+      key._degree    = 0;
+      key._nr_blocks = UNDEFINED;
+      return key;
+    }
+#endif
+
+   private:
+    static u_int8_t const UNDEFINED = 0xff;
+
+    // Returns the smallest index of a block fused with the block pos.
+    static inline size_t find(u_int8_t const* fuse, size_t pos) {
+      while (fuse[pos] < pos) {
+        pos = fuse[pos];
+      }
+      return pos;
+    }
+
+    u_int8_t _degree;
+    u_int8_t _nr_blocks;
+    u_int8_t _blocks[2 * N];
+  };
+
+  static_assert(std::is_trivial<SmallBipartition<64>>(),
+                "SmallBipartition is not a trivial class!");
+}  // namespace libsemigroups
+
+namespace std {
+  template <size_t N> struct hash<libsemigroups::SmallBipartition<N>> {
+    size_t operator()(libsemigroups::SmallBipartition<N> const& x) const {
+      return x.hash_value();
+    }
+  };
+}  // namespace std
+#endif  // LIBSEMIGROUPS_SRC_SMALLBIPART_H_
@@ -0,0 +1,346 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// This file contains a declaration of fast partial permutations of bounded
+// degree.
+
+#ifndef LIBSEMIGROUPS_SRC_SMALLPPERM_H_
+#define LIBSEMIGROUPS_SRC_SMALLPPERM_H_
+
+#include <string.h>
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "hash.h"
+#include "libsemigroups-debug.h"
+
+namespace libsemigroups {
+
+  //! Class for fast partial permutations of degree at most \p N.
+  //!
+  //! A SmallPartialPerm represents the same objects as a PartialPerm of
+  //! degree at most \p N, which must be at most 64. The images of the points
+  //! are stored in an array of \p N bytes inside the object, rather than in
+  //! a vector on the heap, and the domain and image of a SmallPartialPerm
+  //! are stored as bitmasks alongside them. Hence a SmallPartialPerm can be
+  //! multiplied, copied, hashed, and compared without allocating any memory,
+  //! and its rank, domain, and image are available in constant time. This
+  //! makes SmallPartialPerm suitable for use with Semigroup in the same way
+  //! as BMat8.
+  //!
+  //! SmallPartialPerm is a trivial class.
+  template <size_t N> class SmallPartialPerm {
+    static_assert(N > 0 && N <= 64,
+                  "the degree of a SmallPartialPerm must be at most 64");
+
+   public:
+    //! Undefined image value.
+    //!
+    //! This value is used to indicate that a SmallPartialPerm is not defined
+    //! on a point.
+    static u_int8_t const UNDEFINED = 0xff;
+
+    //! A default constructor.
+    //!
+    //! This constructor gives no guarantees on what the partial permutation
+    //! will contain.
+    SmallPartialPerm() = default;
+
+    //! A constructor.
+    //!
+    //! The parameter \p images must be of the same form as the parameter of
+    //! the constructor of PartialPerm<u_int32_t>, i.e. the value in position
+    //! \c i is the image of \c i, or PartialPerm<u_int32_t>::UNDEFINED if
+    //! there is no such image, and the size of \p images, which is the
+    //! degree, must be at most \p N. This method asserts that the values in
+    //! \p images are distinct and less than the degree, unless undefined.
+    //! If \c LIBSEMIGROUPS_DEBUG is not defined, then any values in \p images
+    //! after the first \p N are ignored.
+    explicit SmallPartialPerm(std::vector<u_int32_t> const& images)
+        : _dom(0), _ran(0) {
+      LIBSEMIGROUPS_ASSERT(images.size() <= N);
+      size_t const n = std::min(images.size(), N);
+      _degree        = n;
+      for (size_t i = 0; i < n; i++) {
+        if (images[i] == std::numeric_limits<u_int32_t>::max()) {
+          _images[i] = UNDEFINED;
+        } else {
+          LIBSEMIGROUPS_ASSERT(images[i] < images.size());
+          LIBSEMIGROUPS_ASSERT(!(_ran & bit(images[i])));
+          _images[i] = images[i];
+          _dom |= bit(i);
+          _ran |= bit(images[i]);
+        }
+      }
+    }
+
+    //! A constructor.
+    //!
+    //! Constructs a partial permutation of degree \p deg such that
+    //! \code (dom[i])f = ran[i] \endcode for all \c i and which is undefined
+    //! on every other value less than \p deg. This method asserts that \p dom
+    //! and \p ran have equal size, that \p deg is at most \p N, and that
+    //! every value in \p dom or \p ran is less than \p deg.
+    SmallPartialPerm(std::vector<u_int32_t> const& dom,
+                     std::vector<u_int32_t> const& ran,
+                     size_t                        deg)
+        : _dom(0), _ran(0), _degree(deg) {
+      LIBSEMIGROUPS_ASSERT(dom.size() == ran.size());
+      LIBSEMIGROUPS_ASSERT(deg <= N);
+      memset(_images, UNDEFINED, sizeof(_images));
+      for (size_t i = 0; i < dom.size(); i++) {
+        LIBSEMIGROUPS_ASSERT(dom[i] < deg && ran[i] < deg);
+        LIBSEMIGROUPS_ASSERT(!(_dom & bit(dom[i])));
+        LIBSEMIGROUPS_ASSERT(!(_ran & bit(ran[i])));
+        _images[dom[i]] = ran[i];
+        _dom |= bit(dom[i]);
+        _ran |= bit(ran[i]);
+      }
+    }
+
+    //! A constructor.
+    //!
+    //! This is the copy constructor.
+    SmallPartialPerm(SmallPartialPerm const&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the move constructor.
+    SmallPartialPerm(SmallPartialPerm&&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the copy assignement constructor.
+    SmallPartialPerm& operator=(SmallPartialPerm const&) = default;
+
+    //! A constructor.
+    //!
+    //! This is the move assignment  constructor.
+    SmallPartialPerm& operator=(SmallPartialPerm&&) = default;
+
+    //! A default destructor.
+    ~SmallPartialPerm() = default;
+
+    //! Returns \c true if \c this equals \p that.
+    //!
+    //! This method checks the mathematical equality of two SmallPartialPerm
+    //! objects. Partial permutations with different domains or images are
+    //! distinguished without comparing any images.
+    bool operator==(SmallPartialPerm const& that) const {
+      return _dom == that._dom && _ran == that._ran
+             && _degree == that._degree
+             && memcmp(_images, that._images, _degree) == 0;
+    }
+
+    //! Returns \c true if \c this does not equal \p that.
+    //!
+    //! This method checks the mathematical inequality of two
+    //! SmallPartialPerm objects.
+    bool operator!=(SmallPartialPerm const& that) const {
+      return !(*this == that);
+    }
+
+    //! Returns \c true if \c this is less than \p that.
+    //!
+    //! This defines the same total order as PartialPerm::operator<, which is
+    //! equivalent to that used by GAP.
+    bool operator<(SmallPartialPerm const& that) const {
+      size_t const deg_this = effective_degree();
+      size_t const deg_that = that.effective_degree();
+      if (deg_this != deg_that) {
+        return deg_this < deg_that;
+      }
+      for (size_t i = 0; i < deg_this; i++) {
+        if (_images[i] != that._images[i]) {
+          // Adding 1 maps UNDEFINED to 0, and so below every image.
+          return static_cast<u_int8_t>(_images[i] + 1)
+                 < static_cast<u_int8_t>(that._images[i] + 1);
+        }
+      }
+      return false;
+    }
+
+    //! Returns the image of \p i, or SmallPartialPerm::UNDEFINED.
+    //!
+    //! This method asserts that \p i is less than the degree.
+    inline u_int8_t operator[](size_t i) const {
+      LIBSEMIGROUPS_ASSERT(i < _degree);
+      return _images[i];
+    }
+
+    //! Returns the degree of \c this.
+    inline size_t degree() const {
+      return _degree;
+    }
+
+    //! Returns the rank of \c this.
+    //!
+    //! The *rank* of a partial permutation is the number of points where it
+    //! is defined, which is the number of bits in its domain.
+    inline size_t rank() const {
+      return std::bitset<64>(_dom).count();
+    }
+
+    //! Returns the domain of \c this as a bitmask.
+    //!
+    //! The \c i-th bit of the returned value is set if and only if \c this
+    //! is defined on \c i.
+    inline uint64_t domain_mask() const {
+      return _dom;
+    }
+
+    //! Returns the image of \c this as a bitmask.
+    //!
+    //! The \c i-th bit of the returned value is set if and only if \c i is
+    //! the image of some point under \c this.
+    inline uint64_t image_mask() const {
+      return _ran;
+    }
+
+    //! Returns a hash value for \c this.
+    //!
+    //! Unless libsemigroups is configured with \c --disable-mixhash, this
+    //! method uses hash_bytes.
+    inline size_t hash_value() const {
+#ifdef LIBSEMIGROUPS_USE_MIXHASH
+      return hash_bytes(_images, _degree);
+#else
+      size_t seed = _dom;
+      for (size_t i = 0; i < _degree; i++) {
+        seed ^= _images[i] + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      }
+      return seed;
+#endif
+    }
+
+    //! Returns the product of \c this and \p that.
+    //!
+    //! The product maps \c i to the image under \p that of the image of \c i
+    //! under \c this. This method asserts that the degrees of \c this and
+    //! \p that are equal.
+    SmallPartialPerm operator*(SmallPartialPerm const& that) const {
+      LIBSEMIGROUPS_ASSERT(_degree == that._degree);
+      SmallPartialPerm xy;
+      xy._dom    = 0;
+      xy._ran    = 0;
+      xy._degree = _degree;
+      for (size_t i = 0; i < _degree; i++) {
+        u_int8_t const j = _images[i];
+        if (j != UNDEFINED && that._images[j] != UNDEFINED) {
+          xy._images[i] = that._images[j];
+          xy._dom |= bit(i);
+          xy._ran |= bit(that._images[j]);
+        } else {
+          xy._images[i] = UNDEFINED;
+        }
+      }
+      return xy;
+    }
+
+    //! Returns the inverse of \c this.
+    //!
+    //! The inverse of a partial permutation is defined on its image, and
+    //! maps the image of every point back to that point.
+    SmallPartialPerm inverse() const {
+      SmallPartialPerm inv;
+      inv._dom    = _ran;
+      inv._ran    = _dom;
+      inv._degree = _degree;
+      memset(inv._images, UNDEFINED, sizeof(inv._images));
+      for (size_t i = 0; i < _degree; i++) {
+        if (_images[i] != UNDEFINED) {
+          inv._images[_images[i]] = i;
+        }
+      }
+      return inv;
+    }
+
+    //! Returns the identity SmallPartialPerm.
+    //!
+    //! This method returns the identity partial permutation of degree equal
+    //! to that of \c this, which is defined on every point less than its
+    //! degree.
+    SmallPartialPerm one() const {
+      // The loop runs over all N images, rather than up to the degree, so
+      // that the compiler can see that it stays inside _images.
+      SmallPartialPerm id;
+      id._degree = _degree;
+      id._dom    = (_degree == 64 ? ~uint64_t(0) : bit(_degree) - 1);
+      id._ran    = id._dom;
+      for (size_t i = 0; i < N; i++) {
+        id._images[i] = (i < _degree ? i : UNDEFINED);
+      }
+      return id;
+    }
+
+#if defined(LIBSEMIGROUPS_HAVE_DENSEHASHMAP) \
+    && defined(LIBSEMIGROUPS_USE_DENSEHASHMAP)
+    //! Returns the empty key for google's dense_hash_map.
+    //!
+    //! The returned object has degree 0, but its domain and image masks have
+    //! every bit set, and so it is not equal to any partial permutation.
+    SmallPartialPerm empty_key() const {
+      SmallPartialPerm key;
+      key._dom    = ~uint64_t(0);
+      key._ran    = ~uint64_t(0);
+      key._degree = 0;
+      return key;
+    }
+#endif
+
+   private:
+    static inline uint64_t bit(size_t i) {
+      return uint64_t(1) << i;
+    }
+
+    // Returns one more than the largest point on which this is defined, or
+    // 0 if there is no such point.
+    inline size_t effective_degree() const {
+      size_t d = _degree;
+      while (d > 0 && _images[d - 1] == UNDEFINED) {
+        d--;
+      }
+      return d;
+    }
+
+    uint64_t _dom;
+    uint64_t _ran;
+    u_int8_t _degree;
+    u_int8_t _images[N];
+  };
+
+  template <size_t N> u_int8_t const SmallPartialPerm<N>::UNDEFINED;
+
+  static_assert(std::is_trivial<SmallPartialPerm<64>>(),
+                "SmallPartialPerm is not a trivial class!");
+}  // namespace libsemigroups
+
+namespace std {
+  template <size_t N> struct hash<libsemigroups::SmallPartialPerm<N>> {
+    size_t operator()(libsemigroups::SmallPartialPerm<N> const& x) const {
+      return x.hash_value();
+    }
+  };
+}  // namespace std
+#endif  // LIBSEMIGROUPS_SRC_SMALLPPERM_H_
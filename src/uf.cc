@@ -122,15 +122,16 @@ namespace libsemigroups {
     return _blocks;
   }
 
-  // find
+  // find, with path halving: every entry on the path from i to its root is
+  // replaced by its grandparent. Since every entry is at most its index, this
+  // does not change the invariant used by UF::next_rep and UF::nr_blocks.
   size_t UF::find(size_t i) {
-    size_t ii;
     LIBSEMIGROUPS_ASSERT(_size == _table->size());
-    do {
-      ii = i;
-      LIBSEMIGROUPS_ASSERT(ii < _size);
-      i = (*_table)[ii];
-    } while (ii != i);
+    LIBSEMIGROUPS_ASSERT(i < _size);
+    while ((*_table)[i] != i) {
+      (*_table)[i] = (*_table)[(*_table)[i]];
+      i            = (*_table)[i];
+    }
     return i;
   }
 
@@ -207,4 +208,92 @@ namespace libsemigroups {
       unite((*_table)[i], (*uf._table)[i]);
     }
   }
+
+  // Constructor by size
+  RollbackUF::RollbackUF(size_t size)
+      : _checkpoints(),
+        _log(),
+        _nr_blocks(size),
+        _rank(size, 0),
+        _table() {
+    _table.reserve(size);
+    for (size_t i = 0; i < size; i++) {
+      _table.push_back(i);
+    }
+  }
+
+  // Constructor by table
+  RollbackUF::RollbackUF(table_t const& table)
+      : _checkpoints(),
+        _log(),
+        _nr_blocks(0),
+        _rank(table.size(), 0),
+        _table(table) {
+    // Flatten the table, so that every tree has height at most 1
+    for (size_t i = 0; i < _table.size(); i++) {
+      LIBSEMIGROUPS_ASSERT(_table[i] <= i);
+      if (_table[i] == i) {
+        _nr_blocks++;
+      } else {
+        _table[i]        = _table[_table[i]];
+        _rank[_table[i]] = 1;
+      }
+    }
+  }
+
+  RollbackUF::table_t RollbackUF::get_table() const {
+    size_t const undef = std::numeric_limits<size_t>::max();
+    // The entry in position find(i) of <min> is the least element of the
+    // block of i, since we process i in increasing order.
+    table_t min(_table.size(), undef);
+    table_t table;
+    table.reserve(_table.size());
+    for (size_t i = 0; i < _table.size(); i++) {
+      size_t ii = find(i);
+      if (min[ii] == undef) {
+        min[ii] = i;
+      }
+      table.push_back(min[ii]);
+    }
+    return table;
+  }
+
+  // union
+  bool RollbackUF::unite(size_t i, size_t j) {
+    size_t ii = find(i);
+    size_t jj = find(j);
+    if (ii == jj) {
+      return false;
+    }
+    if (_rank[ii] < _rank[jj]) {
+      std::swap(ii, jj);
+    }
+    // link jj to ii
+    bool rank_increased = (_rank[ii] == _rank[jj]);
+    _table[jj]          = ii;
+    if (rank_increased) {
+      _rank[ii]++;
+    }
+    _nr_blocks--;
+    if (!_checkpoints.empty()) {
+      _log.push_back({jj, rank_increased});
+    }
+    return true;
+  }
+
+  // rollback
+  void RollbackUF::rollback() {
+    LIBSEMIGROUPS_ASSERT(!_checkpoints.empty());
+    size_t checkpoint = _checkpoints.back();
+    _checkpoints.pop_back();
+    while (_log.size() > checkpoint) {
+      log_entry_t const& entry = _log.back();
+      if (entry._rank_increased) {
+        _rank[_table[entry._child]]--;
+      }
+      _table[entry._child] = entry._child;
+      _nr_blocks++;
+      _log.pop_back();
+    }
+  }
 }  // namespace libsemigroups
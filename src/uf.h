@@ -19,14 +19,22 @@
 // This file defines UF, a class used to make an equivalence relation on
 // the integers {1 .. n}, using the UNION-FIND METHOD: new pairs can be added
 // and the appropriate classes combined quickly.
+//
+// This file also defines ConcurrentUF, a lock-free version of UF, which can be
+// used by several threads at once, and RollbackUF, a version of UF where
+// unions can be undone.
 
 #ifndef LIBSEMIGROUPS_SRC_UF_H_
 #define LIBSEMIGROUPS_SRC_UF_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <limits>
 #include <vector>
 
+#include "libsemigroups-debug.h"
+
 namespace libsemigroups {
   class UF {
    public:
@@ -83,6 +91,226 @@ namespace libsemigroups {
     bool      _haschanged;
     size_t    _next_rep;
   };
+
+  // A union-find data structure where the unions performed since a checkpoint
+  // can be undone, for use in backtracking searches.
+  //
+  // Blocks are linked by rank and paths are never compressed, so that every
+  // union changes at most two entries, which are recorded in a log. Hence
+  // RollbackUF::rollback undoes the unions since the last checkpoint in time
+  // proportional to their number, rather than the size of the RollbackUF, and
+  // RollbackUF::find takes O(log n) steps.
+  //
+  // Unlike UF, the representative of a block is not necessarily its least
+  // element, but RollbackUF::get_table returns the table where it is.
+  class RollbackUF {
+   public:
+    typedef UF::table_t table_t;
+
+    // Constructor by size
+    explicit RollbackUF(size_t size);
+
+    // Constructor by table, every entry of the table must be at most its
+    // index.
+    explicit RollbackUF(table_t const& table);
+
+    RollbackUF(RollbackUF const& copy) = delete;
+    RollbackUF& operator=(RollbackUF const& copy) = delete;
+
+    // Getters
+    size_t get_size() const {
+      return _table.size();
+    }
+
+    // Returns the table where the representative of every block is its least
+    // element, this can be used to construct a UF.
+    table_t get_table() const;
+
+    // find
+    size_t find(size_t i) const {
+      LIBSEMIGROUPS_ASSERT(i < _table.size());
+      while (_table[i] != i) {
+        i = _table[i];
+      }
+      return i;
+    }
+
+    // union, returns true if the blocks of i and j were distinct before the
+    // call, and false otherwise.
+    bool unite(size_t i, size_t j);
+
+    // nr_blocks
+    size_t nr_blocks() const {
+      return _nr_blocks;
+    }
+
+    // Record the current partition, so that it can be returned to by
+    // RollbackUF::rollback. Checkpoints can be nested.
+    void checkpoint() {
+      _checkpoints.push_back(_log.size());
+    }
+
+    // Undo every union since the most recent checkpoint, and remove the
+    // checkpoint.
+    void rollback();
+
+    // Returns the number of checkpoints that have not been rolled back.
+    size_t nr_checkpoints() const {
+      return _checkpoints.size();
+    }
+
+   private:
+    // An entry in the undo log: the root which was linked to another root,
+    // and whether the rank of the other root was incremented.
+    struct log_entry_t {
+      size_t _child;
+      bool   _rank_increased;
+    };
+
+    std::vector<size_t>      _checkpoints;
+    std::vector<log_entry_t> _log;
+    size_t                   _nr_blocks;
+    std::vector<u_int8_t>    _rank;
+    table_t                  _table;
+  };
+
+  // A lock-free union-find data structure, for use by several threads at
+  // once.
+  //
+  // The template parameter TIndexType is the type of the entries in the
+  // table, u_int32_t should be used unless the size is at least 2 ^ 32.
+  //
+  // As in UF, the representative of every block is its least element, i.e.
+  // blocks are linked by index, the root with the larger index is made to
+  // point to the root with the smaller index using compare-and-swap. Hence
+  // every entry in the table is at most its index, and so ConcurrentUF::find
+  // terminates after at most i steps, regardless of what any other thread is
+  // doing (i.e. it is wait-free). ConcurrentUF::find does not modify the table
+  // at all, and so it can be used by any number of readers;
+  // ConcurrentUF::find_and_halve also performs path halving.
+  //
+  // It is not possible to add entries to a ConcurrentUF after it is
+  // constructed.
+  template <typename TIndexType = u_int32_t> class ConcurrentUF {
+   public:
+    // Constructor by size
+    explicit ConcurrentUF(size_t size) : _size(size), _table(size) {
+      LIBSEMIGROUPS_ASSERT(size <= std::numeric_limits<TIndexType>::max());
+      for (size_t i = 0; i < size; i++) {
+        _table[i].store(i, std::memory_order_relaxed);
+      }
+    }
+
+    // Constructor by table, every entry of the table must be at most its
+    // index.
+    explicit ConcurrentUF(UF::table_t const& table)
+        : _size(table.size()), _table(table.size()) {
+      LIBSEMIGROUPS_ASSERT(_size <= std::numeric_limits<TIndexType>::max());
+      for (size_t i = 0; i < _size; i++) {
+        LIBSEMIGROUPS_ASSERT(table[i] <= i);
+        _table[i].store(table[i], std::memory_order_relaxed);
+      }
+    }
+
+    ConcurrentUF(ConcurrentUF const& copy) = delete;
+    ConcurrentUF& operator=(ConcurrentUF const& copy) = delete;
+
+    size_t get_size() const {
+      return _size;
+    }
+
+    // find, wait-free and does not modify the table
+    TIndexType find(TIndexType i) const {
+      LIBSEMIGROUPS_ASSERT(i < _size);
+      TIndexType ii = _table[i].load(std::memory_order_acquire);
+      while (ii != i) {
+        i  = ii;
+        ii = _table[i].load(std::memory_order_acquire);
+      }
+      return i;
+    }
+
+    // find, with path halving
+    TIndexType find_and_halve(TIndexType i) {
+      LIBSEMIGROUPS_ASSERT(i < _size);
+      TIndexType ii = _table[i].load(std::memory_order_acquire);
+      while (ii != i) {
+        TIndexType iii = _table[ii].load(std::memory_order_acquire);
+        if (iii != ii) {
+          // If this fails, then another thread changed _table[i] to something
+          // even closer to the root, so there is nothing to do.
+          TIndexType expected = ii;
+          _table[i].compare_exchange_weak(
+              expected, iii, std::memory_order_acq_rel);
+        }
+        i  = ii;
+        ii = iii;
+      }
+      return i;
+    }
+
+    // Returns true if i and j belong to the same block. If another thread is
+    // concurrently uniting blocks, then the return value is correct at some
+    // point during the call.
+    bool same_block(TIndexType i, TIndexType j) {
+      while (true) {
+        i = find_and_halve(i);
+        j = find_and_halve(j);
+        if (i == j) {
+          return true;
+        } else if (_table[i].load(std::memory_order_acquire) == i) {
+          // i is still a root, so i and j are not in the same block
+          return false;
+        }
+      }
+    }
+
+    // union, returns true if the blocks of i and j were distinct before the
+    // call, and false otherwise.
+    bool unite(TIndexType i, TIndexType j) {
+      while (true) {
+        i = find_and_halve(i);
+        j = find_and_halve(j);
+        if (i == j) {
+          return false;
+        } else if (i > j) {
+          std::swap(i, j);
+        }
+        TIndexType jj = j;
+        if (_table[j].compare_exchange_strong(
+                jj, i, std::memory_order_acq_rel)) {
+          return true;
+        }
+        // Another thread made j a non-root, try again
+      }
+    }
+
+    // nr_blocks, this is only meaningful if no other thread is uniting blocks.
+    size_t nr_blocks() const {
+      size_t count = 0;
+      for (size_t i = 0; i < _size; i++) {
+        if (_table[i].load(std::memory_order_relaxed) == i) {
+          count++;
+        }
+      }
+      return count;
+    }
+
+    // Returns a flattened copy of the table, which can be used to construct a
+    // UF. This is only meaningful if no other thread is uniting blocks.
+    UF::table_t get_table() const {
+      UF::table_t table;
+      table.reserve(_size);
+      for (size_t i = 0; i < _size; i++) {
+        table.push_back(find(i));
+      }
+      return table;
+    }
+
+   private:
+    size_t                               _size;
+    std::vector<std::atomic<TIndexType>> _table;
+  };
 }  // namespace libsemigroups
 
 #endif  // LIBSEMIGROUPS_SRC_UF_H_
@@ -0,0 +1,261 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+#include <set>
+
+#include "../src/bmat.h"
+#include "../src/bmat8.h"
+#include "../src/semigroups.h"
+#include "catch.hpp"
+
+#define BMAT_REPORT false
+
+using namespace libsemigroups;
+
+// Returns a random dim x dim matrix, only the first nr_rows of which may be
+// non-zero.
+static std::vector<std::vector<size_t>>
+random_rows(size_t dim, size_t nr_rows, std::mt19937& gen) {
+  std::uniform_int_distribution<size_t> dist(0, 1);
+  std::vector<std::vector<size_t>>      mat(dim, std::vector<size_t>(dim, 0));
+  for (size_t i = 0; i < nr_rows; ++i) {
+    for (size_t j = 0; j < dim; ++j) {
+      mat[i][j] = dist(gen);
+    }
+  }
+  return mat;
+}
+
+template <size_t N>
+static void check_products_and_transpose(size_t dim, std::mt19937& gen) {
+  for (size_t k = 0; k < 20; ++k) {
+    std::vector<std::vector<size_t>> xrows = random_rows(dim, dim, gen);
+    std::vector<std::vector<size_t>> yrows = random_rows(dim, dim, gen);
+    BMat<N>                          x(xrows);
+    BMat<N>                          y(yrows);
+    BMat<N>                          xy = x * y;
+    for (size_t i = 0; i < N; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        bool val = false;
+        for (size_t l = 0; l < dim && i < dim && j < dim; ++l) {
+          val |= (xrows[i][l] && yrows[l][j]);
+        }
+        REQUIRE(xy(i, j) == val);
+        REQUIRE(x.transpose()(i, j) == x(j, i));
+      }
+    }
+    REQUIRE(x.transpose().transpose() == x);
+    REQUIRE((x * y).transpose() == y.transpose() * x.transpose());
+    REQUIRE(x * x.one() == x);
+    REQUIRE(x.one() * x == x);
+  }
+}
+
+// Checks the row space of x against the closure of the rows of x under
+// union.
+template <size_t N> static void check_row_space(BMat<N> const& x) {
+  typedef typename BMat<N>::row_type row_type;
+  std::set<row_type>                 space = {0};
+  for (size_t i = 0; i < N; ++i) {
+    std::set<row_type> next(space);
+    for (row_type r : space) {
+      next.insert(r | x.row(i));
+    }
+    space = next;
+  }
+  REQUIRE(x.row_space_size() == space.size());
+
+  BMat<N> basis = x.row_space_basis();
+  REQUIRE(basis.row_space_basis() == basis);
+  REQUIRE(basis.row_space_size() == space.size());
+  for (size_t i = 0; i < N && basis.row(i) != 0; ++i) {
+    REQUIRE(space.count(basis.row(i)) == 1);
+    if (i > 0) {
+      REQUIRE(basis.row(i - 1) > basis.row(i));
+    }
+    // A basis vector is not the union of the other basis vectors it
+    // contains.
+    row_type cup = 0;
+    for (size_t j = 0; j < N; ++j) {
+      if (j != i && (basis.row(j) | basis.row(i)) == basis.row(i)) {
+        cup |= basis.row(j);
+      }
+    }
+    REQUIRE(cup != basis.row(i));
+  }
+  REQUIRE(x.col_space_size() == x.row_space_size());
+  REQUIRE(x.col_space_basis()
+          == x.transpose().row_space_basis().transpose());
+}
+
+TEST_CASE("BMat 01: methods", "[quick][bmatn][01]") {
+  BMat16 x({{0, 1, 1}, {1, 0, 1}, {0, 0, 0}});
+  BMat16 y({{0, 1, 1}, {1, 0, 1}, {0, 0, 1}});
+  REQUIRE(x != y);
+  REQUIRE(x < y);
+  REQUIRE(y > x);
+  REQUIRE(x(0, 1));
+  REQUIRE(!x(0, 0));
+  REQUIRE(!x(15, 15));
+  REQUIRE(x.row(0) == 0x6000);
+  REQUIRE(x * y == BMat16({{1, 0, 1}, {0, 1, 1}}));
+  REQUIRE(x.transpose() == BMat16({{0, 1}, {1, 0}, {1, 1}}));
+
+  x.set(2, 2, true);
+  REQUIRE(x == y);
+  x.set(0, 1, false);
+  REQUIRE(x == BMat16({{0, 0, 1}, {1, 0, 1}, {0, 0, 1}}));
+  x.set(15, 15, true);
+  REQUIRE(x(15, 15));
+
+  REQUIRE(BMat64(std::vector<std::vector<size_t>>()).one()
+          == BMat64(std::vector<std::vector<size_t>>()).one().transpose());
+  REQUIRE(std::hash<BMat16>()(y) == std::hash<BMat16>()(BMat16(y)));
+
+  std::ostringstream oss;
+  oss << BMat16({{1, 0, 1}});
+  REQUIRE(oss.str().substr(0, 17) == "1010000000000000\n");
+}
+
+TEST_CASE("BMat 02: products and transposes", "[quick][bmatn][02]") {
+  std::mt19937 gen(1);
+  for (size_t dim : {1, 7, 10, 16}) {
+    check_products_and_transpose<16>(dim, gen);
+  }
+  for (size_t dim : {17, 20, 32}) {
+    check_products_and_transpose<32>(dim, gen);
+  }
+  for (size_t dim : {33, 50, 64}) {
+    check_products_and_transpose<64>(dim, gen);
+  }
+}
+
+TEST_CASE("BMat 03: agrees with BMat8", "[quick][bmatn][03]") {
+  std::mt19937 gen(1);
+  for (size_t k = 0; k < 100; ++k) {
+    std::vector<std::vector<size_t>> xrows = random_rows(8, 8, gen);
+    std::vector<std::vector<size_t>> yrows = random_rows(8, 8, gen);
+    REQUIRE((BMat8(xrows) < BMat8(yrows))
+            == (BMat32(xrows) < BMat32(yrows)));
+    BMat8  xy  = BMat8(xrows) * BMat8(yrows);
+    BMat32 xy2 = BMat32(xrows) * BMat32(yrows);
+    for (size_t i = 0; i < 8; ++i) {
+      for (size_t j = 0; j < 8; ++j) {
+        REQUIRE(xy(i, j) == xy2(i, j));
+      }
+    }
+  }
+}
+
+TEST_CASE("BMat 04: row and column spaces", "[quick][bmatn][04]") {
+  std::mt19937 gen(1);
+  REQUIRE(BMat16(std::vector<std::vector<size_t>>()).row_space_size() == 1);
+  REQUIRE(BMat16({{1, 1}, {1}, {0, 1}}).row_space_basis()
+          == BMat16({{1}, {0, 1}}));
+  REQUIRE(BMat16({{1, 1}, {1}, {0, 1}}).row_space_size() == 4);
+
+  // Row spaces with many elements, whose bases split into classes of
+  // vectors connected by non-empty intersections.
+  std::vector<std::vector<size_t>> id(32, std::vector<size_t>(32, 0));
+  for (size_t i = 0; i < 32; ++i) {
+    id[i][i] = 1;
+  }
+  REQUIRE(BMat32(id).row_space_size() == (size_t(1) << 32));
+  REQUIRE(BMat64(id).row_space_size() == (size_t(1) << 32));
+  id.resize(64, std::vector<size_t>(64, 0));
+  for (size_t i = 0; i < 64; ++i) {
+    id[i].resize(64, 0);
+    id[i][i] = 1;
+  }
+  REQUIRE(BMat64(id).row_space_size() == 0);
+  for (size_t i = 0; i < 64; i += 2) {
+    id[i][i + 1] = 1;
+  }
+  // The classes are {{i, i + 1}, {i + 1}}, each with 3 unions.
+  size_t pow3 = 1;
+  for (size_t i = 0; i < 32; ++i) {
+    pow3 *= 3;
+  }
+  REQUIRE(BMat64(id).row_space_size() == pow3);
+
+  for (size_t k = 0; k < 20; ++k) {
+    check_row_space(BMat16(random_rows(16, 9, gen)));
+    check_row_space(BMat16(random_rows(16, 12, gen)));
+    check_row_space(BMat32(random_rows(32, 8, gen)));
+    check_row_space(BMat64(random_rows(64, 8, gen)));
+  }
+}
+
+TEST_CASE("BMat 05: regular boolean mat monoid 4",
+          "[quick][bmatn][semigroup][05]") {
+  std::vector<std::vector<std::vector<size_t>>> gens
+      = {{{0, 1, 0, 0}, {1, 0, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}},
+         {{0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}, {1, 0, 0, 0}},
+         {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 1}},
+         {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 0}}};
+
+  Semigroup<BMat16> S({BMat16(gens[0]),
+                       BMat16(gens[1]),
+                       BMat16(gens[2]),
+                       BMat16(gens[3])});
+  S.set_report(BMAT_REPORT);
+  REQUIRE(S.size() == 63904);
+  REQUIRE(S.nridempotents() == 2360);
+  REQUIRE(
+      S.word_to_element({0, 1, 2, 0, 1, 2})
+      == BMat16({{1, 0, 0, 1}, {0, 1, 0, 0}, {1, 0, 1, 0}, {0, 0, 1, 0}}));
+
+  Semigroup<BMat64> T({BMat64(gens[0]),
+                       BMat64(gens[1]),
+                       BMat64(gens[2]),
+                       BMat64(gens[3])});
+  T.set_report(BMAT_REPORT);
+  REQUIRE(T.size() == 63904);
+  REQUIRE(T.nrrules() == S.nrrules());
+}
+
+TEST_CASE("BMat 06: agrees with BooleanMat in dimension 10",
+          "[quick][bmatn][semigroup][06]") {
+  std::vector<std::vector<bool>> x(10, std::vector<bool>(10, false));
+  std::vector<std::vector<bool>> y(10, std::vector<bool>(10, false));
+  for (size_t i = 0; i < 10; ++i) {
+    x[i][(i + 1) % 10] = true;
+    y[i][i]            = (i != 0);
+  }
+  std::vector<BMat16> bmats;
+  for (auto const& z : {x, y}) {
+    std::vector<std::vector<size_t>> rows;
+    for (auto const& row : z) {
+      rows.emplace_back(row.begin(), row.end());
+    }
+    bmats.emplace_back(rows);
+  }
+  Semigroup<BMat16> S(bmats);
+  S.set_report(BMAT_REPORT);
+
+  std::vector<Element*> gens = {new BooleanMat(x), new BooleanMat(y)};
+  Semigroup<>           T(gens);
+  really_delete_cont(gens);
+  T.set_report(BMAT_REPORT);
+
+  REQUIRE(S.size() == 10231);
+  REQUIRE(T.size() == 10231);
+  REQUIRE(S.nrrules() == T.nrrules());
+  REQUIRE(S.nridempotents() == T.nridempotents());
+}
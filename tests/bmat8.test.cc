@@ -17,6 +17,7 @@
 
 #include "catch.hpp"
 
+#include "../src/bmat.h"
 #include "../src/bmat8.h"
 
 #define BMAT_REPORT false
@@ -231,3 +232,103 @@ TEST_CASE("BMat8 07: set", "[quick][bmat][07]") {
   BMat8 zeros(0);
   REQUIRE(bm == zeros);
 }
+
+TEST_CASE("BMat8 08: row and column spaces", "[quick][bmat][08]") {
+  BMat8 bm({{1, 1, 0}, {1, 0, 0}, {0, 1, 0}});
+  REQUIRE(bm.row_space_basis() == BMat8({{1, 0, 0}, {0, 1, 0}, {0, 0, 0}}));
+  REQUIRE(bm.row_space_size() == 4);
+  REQUIRE(bm.col_space_basis() == bm);
+  REQUIRE(bm.col_space_size() == 4);
+  REQUIRE(BMat8(0).row_space_size() == 1);
+  REQUIRE(BMat8(0).row_space_basis() == BMat8(0));
+  REQUIRE(bm.one().row_space_size() == 256);
+  REQUIRE(bm.row_space_equal(bm.row_space_basis()));
+  REQUIRE(!bm.row_space_equal(bm.one()));
+  REQUIRE(bm.row_space_included(bm.one()));
+  REQUIRE(!bm.one().row_space_included(bm));
+
+  // Compare with the row spaces of BMat16, computed one row at a time.
+  for (size_t k = 0; k < 1000; ++k) {
+    BMat8                            x = BMat8::random();
+    BMat8                            y = BMat8::random(k % 8 + 1);
+    std::vector<std::vector<size_t>> rows(8, std::vector<size_t>(8, 0));
+    for (size_t i = 0; i < 8; ++i) {
+      for (size_t j = 0; j < 8; ++j) {
+        rows[i][j] = x(i, j);
+      }
+    }
+    BMat16 const basis = BMat16(rows).row_space_basis();
+    for (size_t i = 0; i < 8; ++i) {
+      for (size_t j = 0; j < 8; ++j) {
+        REQUIRE(x.row_space_basis()(i, j) == basis(i, j));
+      }
+    }
+    REQUIRE(x.row_space_size() == BMat16(rows).row_space_size());
+    REQUIRE(x.col_space_size() == x.row_space_size());
+    REQUIRE(x.row_space_equal(x.row_space_basis()));
+    REQUIRE(x.row_space_equal(x.transpose().col_space_basis().transpose()));
+    REQUIRE((x * y).row_space_included(y));
+    REQUIRE(x.row_space_equal(y)
+            == (x.row_space_basis() == y.row_space_basis()));
+  }
+}
+
+TEST_CASE("BMat8 09: batch methods", "[quick][bmat][09]") {
+  std::vector<BMat8> in;
+  for (size_t i = 0; i < 1000; ++i) {
+    in.push_back(BMat8::random(i % 8 + 1));
+  }
+  BMat8 const        x = BMat8::random();
+  std::vector<BMat8> out(in.size());
+
+  BMat8::multiply_left(x, in.data(), out.data(), in.size());
+  for (size_t i = 0; i < in.size(); ++i) {
+    REQUIRE(out[i] == x * in[i]);
+  }
+  BMat8::multiply_right(x, in.data(), out.data(), in.size());
+  for (size_t i = 0; i < in.size(); ++i) {
+    REQUIRE(out[i] == in[i] * x);
+  }
+  BMat8::transpose(in.data(), out.data(), in.size());
+  for (size_t i = 0; i < in.size(); ++i) {
+    REQUIRE(out[i] == in[i].transpose());
+  }
+  std::vector<size_t> hashes(in.size());
+  BMat8::hash(in.data(), hashes.data(), in.size());
+  for (size_t i = 0; i < in.size(); ++i) {
+    REQUIRE(hashes[i] == std::hash<BMat8>()(in[i]));
+  }
+
+  // The arrays in and out can be the same.
+  out = in;
+  BMat8::multiply_left(x, out.data(), out.data(), out.size());
+  for (size_t i = 0; i < in.size(); ++i) {
+    REQUIRE(out[i] == x * in[i]);
+  }
+  BMat8::multiply_left(x, out.data(), out.data(), 0);
+  BMat8::multiply_right(x.one(), in.data(), out.data(), in.size());
+  REQUIRE(out == in);
+
+  // Arrays whose lengths are not multiples of 4, in case the batch methods
+  // process several BMat8s at a time.
+  for (size_t n = 0; n < 10; ++n) {
+    std::vector<BMat8> part(in.begin(), in.begin() + n);
+    std::vector<BMat8> prod(n);
+    BMat8::multiply_left(x, part.data(), prod.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      REQUIRE(prod[i] == x * part[i]);
+    }
+    BMat8::multiply_right(x, part.data(), prod.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      REQUIRE(prod[i] == part[i] * x);
+    }
+    BMat8::transpose(part.data(), prod.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      REQUIRE(prod[i] == part[i].transpose());
+    }
+    BMat8::hash(part.data(), hashes.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      REQUIRE(hashes[i] == std::hash<BMat8>()(part[i]));
+    }
+  }
+}
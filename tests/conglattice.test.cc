@@ -0,0 +1,116 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2017 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// The purpose of this file is to test the CongruenceLattice class.
+
+#include <utility>
+
+#include "../src/cong.h"
+#include "../src/conglattice.h"
+#include "catch.hpp"
+
+#define CONGLATTICE_REPORT false
+
+using namespace libsemigroups;
+
+TEST_CASE("CongruenceLattice 01: symmetric group of degree 3",
+          "[quick][conglattice][01]") {
+  std::vector<Element*> gens = {new Transformation<u_int16_t>({1, 0, 2}),
+                                new Transformation<u_int16_t>({1, 2, 0})};
+  Semigroup<>           S    = Semigroup<>(gens);
+  S.set_report(CONGLATTICE_REPORT);
+  really_delete_cont(gens);
+
+  // The two-sided congruences correspond to the normal subgroups
+  CongruenceLattice twosided("twosided", &S);
+  twosided.set_report(CONGLATTICE_REPORT);
+  REQUIRE(twosided.nr_principal_congruences() == 2);
+  REQUIRE(twosided.nr_congruences() == 3);
+  REQUIRE(twosided.nr_classes(0) == 6);
+
+  // The left congruences correspond to the subgroups, and the principal ones
+  // to the non-trivial cyclic subgroups
+  CongruenceLattice left("left", &S);
+  left.set_report(CONGLATTICE_REPORT);
+  REQUIRE(left.nr_principal_congruences() == 4);
+  REQUIRE(left.nr_congruences() == 6);
+
+  CongruenceLattice right("right", &S);
+  right.set_report(CONGLATTICE_REPORT);
+  right.set_max_threads(1);
+  REQUIRE(right.nr_congruences() == 6);
+}
+
+TEST_CASE("CongruenceLattice 02: principal congruences agree with Congruence",
+          "[quick][conglattice][02]") {
+  std::vector<Element*> gens = {new Transformation<u_int16_t>({1, 3, 4, 2, 3}),
+                                new Transformation<u_int16_t>({3, 2, 1, 3, 3})};
+  Semigroup<>           S    = Semigroup<>(gens);
+  S.set_report(CONGLATTICE_REPORT);
+  really_delete_cont(gens);
+  REQUIRE(S.size() == 88);
+
+  CongruenceLattice lattice("twosided", &S);
+  lattice.set_report(CONGLATTICE_REPORT);
+  lattice.set_max_threads(4);
+
+  word_t w1, w2;
+  for (size_t i = 0; i < S.size(); i += 7) {
+    for (size_t j = i + 1; j < S.size(); j += 11) {
+      S.factorisation(w1, i);
+      S.factorisation(w2, j);
+      Congruence cong("twosided", &S, {relation_t(w1, w2)});
+      cong.set_report(CONGLATTICE_REPORT);
+      CongruenceLattice::cong_index_t c = lattice.principal_congruence(i, j);
+      REQUIRE(c == lattice.principal_congruence(j, i));
+      REQUIRE(c > 0);
+      REQUIRE(c <= lattice.nr_principal_congruences());
+      REQUIRE(lattice.nr_classes(c) == cong.nr_classes());
+      REQUIRE(lattice.congruence(c)[i] == lattice.congruence(c)[j]);
+    }
+  }
+  REQUIRE(lattice.principal_congruence(3, 3) == 0);
+}
+
+TEST_CASE("CongruenceLattice 03: joins and containment",
+          "[quick][conglattice][03]") {
+  std::vector<Element*> gens = {new Transformation<u_int16_t>({1, 2, 0}),
+                                new Transformation<u_int16_t>({1, 0, 2}),
+                                new Transformation<u_int16_t>({0, 0, 2})};
+  Semigroup<>           S    = Semigroup<>(gens);
+  S.set_report(CONGLATTICE_REPORT);
+  really_delete_cont(gens);
+  REQUIRE(S.size() == 27);
+
+  CongruenceLattice lattice("twosided", &S);
+  lattice.set_report(CONGLATTICE_REPORT);
+  size_t n = lattice.nr_congruences();
+  // The congruences of the full transformation monoid of degree 3 form a
+  // chain of length 7.
+  REQUIRE(n == 7);
+  for (size_t i = 0; i < n; i++) {
+    REQUIRE(lattice.is_contained(0, i));
+    REQUIRE(lattice.join(0, i) == i);
+    REQUIRE(lattice.join(i, i) == i);
+    for (size_t j = 0; j < n; j++) {
+      REQUIRE((lattice.is_contained(i, j) || lattice.is_contained(j, i)));
+      REQUIRE(lattice.join(i, j) == lattice.join(j, i));
+    }
+  }
+  REQUIRE(lattice.current_nr_congruences() == n);
+}
@@ -16,6 +16,8 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <random>
+
 #include "catch.hpp"
 
 #include "../src/elements.h"
@@ -192,6 +194,37 @@ TEST_CASE("Transformation 06: u_int32_t delete/copy",
   delete expected;
 }
 
+#ifdef LIBSEMIGROUPS_USE_MIXHASH
+TEST_CASE("Transformation 07: u_int32_t hash, large degree",
+          "[quick][element][transformation][07]") {
+  // The polynomial hash function gives x and y the same hash value, since
+  // the image of 0 is multiplied by 64 ^ 63 = 0 mod 2 ^ 64.
+  std::vector<u_int32_t> imgs(64);
+  for (size_t i = 0; i < 64; i++) {
+    imgs[i] = i;
+  }
+  Transformation<u_int32_t> x(imgs);
+  imgs[0] = 1;
+  Transformation<u_int32_t> y(imgs);
+  REQUIRE(!(x == y));
+  REQUIRE(x.hash_value() != y.hash_value());
+
+  Element* z = y.really_copy();
+  REQUIRE(z->hash_value() == y.hash_value());
+
+  std::vector<u_int64_t> zeros(8, 0);
+  REQUIRE(hash_bytes(zeros.data(), 0) != hash_bytes(zeros.data(), 8));
+  REQUIRE(hash_bytes(zeros.data(), 8) != hash_bytes(zeros.data(), 16));
+  REQUIRE(hash_bytes(zeros.data(), 63) != hash_bytes(zeros.data(), 64));
+  REQUIRE(hash_bytes(imgs.data(), 256) == hash_bytes(imgs.data(), 256));
+
+  x.really_delete();
+  y.really_delete();
+  z->really_delete();
+  delete z;
+}
+#endif
+
 TEST_CASE("PartialPerm 01: u_int16_t methods", "[quick][element][pperm][01]") {
   Element* x = new PartialPerm<u_int16_t>({4, 5, 0}, {10, 0, 1}, 10);
   Element* y = new PartialPerm<u_int16_t>({4, 5, 0}, {10, 0, 1}, 10);
@@ -1303,3 +1336,185 @@ TEST_CASE("PBR 05: delete/copy", "[quick][element][pbr][05]") {
   a->really_delete();
   delete a;
 }
+
+TEST_CASE("BitPBR 01: methods", "[quick][element][pbr][bitpbr][01]") {
+  Element* x = new BitPBR({{1}, {4}, {3}, {1}, {0, 2}, {0, 3, 4, 5}});
+  Element* y
+      = new BitPBR({{1, 2}, {0, 1}, {0, 2, 3}, {0, 1, 2}, {3}, {0, 3, 4, 5}});
+  REQUIRE(!(*x == *y));
+  y->redefine(x, x);
+  Element* z
+      = new BitPBR({{1}, {4}, {0, 2}, {0, 2}, {0, 1, 2, 3, 4}, {1, 3, 4, 5}});
+  REQUIRE(*y == *z);
+  z->really_delete();
+  delete z;
+
+  REQUIRE(x->degree() == 3);
+  REQUIRE(y->degree() == 3);
+  REQUIRE(x->complexity() == 72);
+  Element* id = x->identity();
+  y->redefine(id, x);
+  REQUIRE(*y == *x);
+  y->redefine(x, id);
+  REQUIRE(*y == *x);
+
+  Element* a = x->really_copy();
+  REQUIRE(*a == *x);
+  a->swap(y);
+  REQUIRE(*a == *x);
+
+  x->really_delete();
+  delete x;
+  y->really_delete();
+  delete y;
+  id->really_delete();
+  delete id;
+  a->really_delete();
+  delete a;
+}
+
+TEST_CASE("BitPBR 02: products agree with PBR",
+          "[quick][element][pbr][bitpbr][02]") {
+  // Degrees for which the rows of a BitPBR consist of 1, 2, and 3 words.
+  for (u_int32_t n : {1, 5, 31, 32, 33, 40, 64, 65}) {
+    std::vector<std::vector<std::vector<u_int32_t>>> adjs;
+    for (size_t s = 0; s < 4; s++) {
+      std::vector<std::vector<u_int32_t>> adj(2 * n);
+      for (u_int32_t i = 0; i < 2 * n; i++) {
+        for (u_int32_t j = 0; j < 2 * n; j++) {
+          // Sparse enough that products are not the universal PBR.
+          if ((i * 7 + j * 13 + s * 5) % (2 * n + 3) == 0
+              || (s % 2 == 0 && j == (i + n) % (2 * n))) {
+            adj[i].push_back(j);
+          }
+        }
+      }
+      adjs.push_back(adj);
+    }
+    for (auto const& adj_x : adjs) {
+      for (auto const& adj_y : adjs) {
+        PBR x(adj_x);
+        PBR y(adj_y);
+        PBR xy(adj_x);
+        xy.redefine(&x, &y, 0);
+
+        BitPBR bx(adj_x);
+        BitPBR by(adj_y);
+        BitPBR bxy(adj_x);
+        bxy.redefine(&bx, &by, 0);
+        BitPBR expected(
+            std::vector<std::vector<u_int32_t>>(xy.begin(), xy.end()));
+        REQUIRE(bxy.degree() == n);
+        REQUIRE(bxy == expected);
+
+        for (Element* e : std::vector<Element*>(
+                 {&x, &y, &xy, &bx, &by, &bxy, &expected})) {
+          e->really_delete();
+        }
+      }
+    }
+  }
+}
+
+// Checks that the products of some pseudo-random matrices over TSemiring
+// agree with those over the Semiring sr.
+template <typename TSemiring>
+static void
+check_static_matrix_products(Semiring<int64_t> const* sr,
+                             std::vector<int64_t> const& values) {
+  std::mt19937                          gen(1);
+  std::uniform_int_distribution<size_t> dist(0, values.size() - 1);
+  for (size_t n = 1; n < 10; n++) {
+    for (size_t k = 0; k < 20; k++) {
+      std::vector<int64_t> xv(n * n), yv(n * n);
+      for (size_t i = 0; i < n * n; i++) {
+        xv[i] = values[dist(gen)];
+        yv[i] = values[dist(gen)];
+      }
+      MatrixOverSemiring<int64_t> x(new std::vector<int64_t>(xv), sr);
+      MatrixOverSemiring<int64_t> y(new std::vector<int64_t>(yv), sr);
+      MatrixOverSemiring<int64_t> xy(new std::vector<int64_t>(xv), sr);
+      xy.redefine(&x, &y);
+
+      StaticMatrixOverSemiring<TSemiring> sx(new std::vector<int64_t>(xv));
+      StaticMatrixOverSemiring<TSemiring> sy(new std::vector<int64_t>(yv));
+      StaticMatrixOverSemiring<TSemiring> sxy(new std::vector<int64_t>(xv));
+      sxy.redefine(&sx, &sy);
+      REQUIRE(sxy.degree() == n);
+      REQUIRE(std::equal(sxy.begin(), sxy.end(), xy.begin()));
+
+      Element* id = sx.identity();
+      sxy.redefine(id, &sx);
+      REQUIRE(sxy == sx);
+      sxy.redefine(&sx, id);
+      REQUIRE(sxy == sx);
+
+      for (Element* e : std::vector<Element*>({&x, &y, &xy, &sx, &sy, &sxy})) {
+        e->really_delete();
+      }
+      id->really_delete();
+      delete id;
+    }
+  }
+}
+
+TEST_CASE("StaticMatrixOverSemiring 01: products agree with "
+          "MatrixOverSemiring",
+          "[quick][element][matrix][staticmatrix][01]") {
+  int64_t const MINUS_INFTY = Semiring<int64_t>::MINUS_INFTY;
+  int64_t const INFTY       = Semiring<int64_t>::INFTY;
+
+  Semiring<int64_t>* sr = new Integers();
+  check_static_matrix_products<StaticIntegers>(sr, {-3, -1, 0, 1, 2, 5});
+  delete sr;
+
+  sr = new MaxPlusSemiring();
+  check_static_matrix_products<StaticMaxPlusSemiring>(
+      sr, {MINUS_INFTY, -4, 0, 1, 7, 100});
+  delete sr;
+
+  sr = new MinPlusSemiring();
+  check_static_matrix_products<StaticMinPlusSemiring>(
+      sr, {INFTY, -4, 0, 1, 7, 100});
+  delete sr;
+
+  sr = new TropicalMaxPlusSemiring(33);
+  check_static_matrix_products<StaticTropicalMaxPlusSemiring<33>>(
+      sr, {MINUS_INFTY, 0, 1, 10, 20, 33});
+  delete sr;
+
+  sr = new TropicalMinPlusSemiring(11);
+  check_static_matrix_products<StaticTropicalMinPlusSemiring<11>>(
+      sr, {INFTY, 0, 1, 5, 10, 11});
+  delete sr;
+
+  sr = new NaturalSemiring(11, 3);
+  check_static_matrix_products<StaticNaturalSemiring<11, 3>>(
+      sr, {0, 1, 2, 5, 11, 13});
+  delete sr;
+}
+
+TEST_CASE("StaticMatrixOverSemiring 02: methods",
+          "[quick][element][matrix][staticmatrix][02]") {
+  using Mat = StaticMatrixOverSemiring<StaticTropicalMaxPlusSemiring<9>>;
+  int64_t const MINUS_INFTY = Semiring<int64_t>::MINUS_INFTY;
+
+  Element* x = new Mat({{1, 0, 2}, {MINUS_INFTY, 9, 3}, {4, 5, 0}});
+  Element* y = x->really_copy();
+  REQUIRE(*x == *y);
+  REQUIRE(x->degree() == 3);
+  REQUIRE(x->complexity() == 27);
+  REQUIRE(x->hash_value() == y->hash_value());
+
+  y->redefine(x, x);
+  Element* expected = new Mat({{6, 9, 3}, {7, 9, 9}, {5, 9, 8}});
+  REQUIRE(*y == *expected);
+  REQUIRE(*x < *y);
+
+  x->really_delete();
+  delete x;
+  y->really_delete();
+  delete y;
+  expected->really_delete();
+  delete expected;
+}
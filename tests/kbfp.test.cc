@@ -268,3 +268,36 @@ TEST_CASE("KBFP 07: fp semigroup, size 240",
 
   REQUIRE(cong.nr_classes() == 240);
 }
+
+TEST_CASE("KBFP 08: Knuth-Bendix shared with KBP",
+          "[quick][congruence][kbfp][fpsemigroup][08]") {
+  std::vector<relation_t> rels;
+  rels.push_back(relation_t({0, 0, 0}, {0}));  // (a^3, a)
+  rels.push_back(relation_t({0}, {1, 1}));     // (a, b^2)
+
+  Congruence cong1("twosided", 2, rels, std::vector<relation_t>());
+  cong1.set_report(KBFP_REPORT);
+  cong1.force_kbp();
+  REQUIRE(cong1.nr_classes() == 5);
+  cong1.force_kbfp();
+  REQUIRE(cong1.nr_classes() == 5);
+  REQUIRE(cong1.word_to_class_index({0, 0, 1})
+          == cong1.word_to_class_index({0, 0, 0, 0, 1}));
+  REQUIRE(cong1.word_to_class_index({0, 0, 0})
+          != cong1.word_to_class_index({1}));
+
+  // Racing KBFP and KBP (and TC)
+  Congruence cong2("twosided", 2, rels, std::vector<relation_t>());
+  cong2.set_report(KBFP_REPORT);
+  REQUIRE(cong2.nr_classes() == 5);
+
+  std::vector<relation_t> extra = {relation_t({0}, {0, 0})};
+  Congruence              cong3("twosided", 2, rels, extra);
+  cong3.set_report(KBFP_REPORT);
+  cong3.force_kbp();
+  REQUIRE(cong3.nr_classes() == 3);
+  cong3.force_kbfp();
+  REQUIRE(cong3.nr_classes() == 3);
+  REQUIRE(cong3.word_to_class_index({0, 1})
+          == cong3.word_to_class_index({1, 0, 0}));
+}
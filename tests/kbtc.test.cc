@@ -0,0 +1,145 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2017 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+// The purpose of this file is to test the Congruence::KBTC class, this is
+// achieved by calling cong.force_kbtc() before calculating anything about the
+// congruence.
+
+#include <utility>
+
+#include "../src/cong.h"
+#include "catch.hpp"
+
+#define KBTC_REPORT false
+
+using namespace libsemigroups;
+
+TEST_CASE("KBTC 01: Small fp semigroup",
+          "[quick][congruence][kbtc][fpsemigroup][01]") {
+  std::vector<relation_t> rels;
+  rels.push_back(relation_t({0, 0, 0}, {0}));  // (a^3, a)
+  rels.push_back(relation_t({0}, {1, 1}));     // (a, b^2)
+  std::vector<relation_t> extra;
+
+  Congruence cong("twosided", 2, rels, extra);
+  cong.force_kbtc();
+  cong.set_report(KBTC_REPORT);
+
+  REQUIRE(!cong.is_done());
+  REQUIRE(cong.nr_classes() == 5);
+  REQUIRE(cong.is_done());
+
+  REQUIRE(cong.word_to_class_index({0, 0, 1})
+          == cong.word_to_class_index({0, 0, 0, 0, 1}));
+  REQUIRE(cong.word_to_class_index({0, 1, 1, 0, 0, 1})
+          == cong.word_to_class_index({0, 0, 0, 0, 1}));
+  REQUIRE(cong.word_to_class_index({0, 0, 0})
+          != cong.word_to_class_index({1}));
+}
+
+TEST_CASE("KBTC 02: left and right congruences on fp semigroup",
+          "[quick][congruence][kbtc][fpsemigroup][02]") {
+  std::vector<relation_t> rels;
+  rels.push_back(relation_t({0, 0, 0}, {0}));  // (a^3, a)
+  rels.push_back(relation_t({0}, {1, 1}));     // (a, b^2)
+  std::vector<relation_t> extra = {relation_t({0}, {0, 0})};
+
+  Congruence left("left", 2, rels, extra);
+  left.force_kbtc();
+  left.set_report(KBTC_REPORT);
+  REQUIRE(left.nr_classes() == 3);
+  REQUIRE(left.word_to_class_index({0, 0, 1})
+          == left.word_to_class_index({0, 1}));
+  REQUIRE(left.word_to_class_index({1})
+          != left.word_to_class_index({0, 1}));
+
+  Congruence right("right", 2, rels, extra);
+  right.force_kbtc();
+  right.set_report(KBTC_REPORT);
+  REQUIRE(right.nr_classes() == 3);
+  REQUIRE(right.word_to_class_index({1, 0, 0})
+          == right.word_to_class_index({1, 0}));
+  REQUIRE(right.word_to_class_index({1})
+          != right.word_to_class_index({1, 0}));
+}
+
+TEST_CASE("KBTC 03: finite fp-semigroup, dihedral group of order 6",
+          "[quick][congruence][kbtc][fpsemigroup][03]") {
+  std::vector<relation_t> rels = {relation_t({0, 0}, {0}),
+                                  relation_t({0, 1}, {1}),
+                                  relation_t({1, 0}, {1}),
+                                  relation_t({0, 2}, {2}),
+                                  relation_t({2, 0}, {2}),
+                                  relation_t({0, 3}, {3}),
+                                  relation_t({3, 0}, {3}),
+                                  relation_t({0, 4}, {4}),
+                                  relation_t({4, 0}, {4}),
+                                  relation_t({1, 2}, {0}),
+                                  relation_t({2, 1}, {0}),
+                                  relation_t({3, 4}, {0}),
+                                  relation_t({4, 3}, {0}),
+                                  relation_t({2, 2}, {0}),
+                                  relation_t({1, 4, 2, 3, 3}, {0}),
+                                  relation_t({4, 4, 4}, {0})};
+
+  Congruence cong("twosided", 5, rels, std::vector<relation_t>());
+  cong.force_kbtc();
+  cong.set_report(KBTC_REPORT);
+
+  REQUIRE(cong.nr_classes() == 6);
+  REQUIRE(cong.word_to_class_index({1}) == cong.word_to_class_index({2}));
+}
+
+TEST_CASE("KBTC 04: Example 6.6 in Sims (see also TC 17)",
+          "[quick][congruence][kbtc][fpsemigroup][04]") {
+  std::vector<relation_t> rels
+      = {relation_t({0, 0}, {0}),
+         relation_t({1, 0}, {1}),
+         relation_t({0, 1}, {1}),
+         relation_t({2, 0}, {2}),
+         relation_t({0, 2}, {2}),
+         relation_t({3, 0}, {3}),
+         relation_t({0, 3}, {3}),
+         relation_t({1, 1}, {0}),
+         relation_t({2, 3}, {0}),
+         relation_t({2, 2, 2}, {0}),
+         relation_t({1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2}, {0}),
+         relation_t({1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3,
+                     1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3, 1, 2, 1, 3},
+                    {0})};
+  Congruence cong("twosided", 4, rels, std::vector<relation_t>());
+  cong.set_report(KBTC_REPORT);
+  cong.force_kbtc();
+  REQUIRE(cong.nr_classes() == 10752);
+  REQUIRE(cong.word_to_class_index({2, 3})
+          == cong.word_to_class_index({0}));
+}
+
+TEST_CASE("KBTC 05: racing with the other methods",
+          "[quick][congruence][kbtc][fpsemigroup][05]") {
+  std::vector<relation_t> rels;
+  rels.push_back(relation_t({0, 0, 0}, {0}));  // (a^3, a)
+  rels.push_back(relation_t({0}, {1, 1}));     // (a, b^2)
+  std::vector<relation_t> extra = {relation_t({0}, {0, 0})};
+
+  Congruence cong("twosided", 2, rels, extra);
+  cong.set_report(KBTC_REPORT);
+  REQUIRE(cong.nr_classes() == 3);
+  REQUIRE(cong.word_to_class_index({0, 1})
+          == cong.word_to_class_index({1, 0, 0}));
+}
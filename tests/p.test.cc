@@ -413,3 +413,120 @@ TEST_CASE("P 10: left congruence on big finite semigroup",
   REQUIRE(cong.nr_classes() == 7449);
   REQUIRE(S.is_done());  // nr_classes requires S.size();
 }
+
+TEST_CASE("P 11: congruence on enumerated finite semigroup",
+          "[quick][congruence][p][finite][11]") {
+  std::vector<Element*> gens = {new Transformation<u_int16_t>({1, 3, 4, 2, 3}),
+                                new Transformation<u_int16_t>({3, 2, 1, 3, 3})};
+  Semigroup<>           S    = Semigroup<>(gens);
+  S.set_report(P_REPORT);
+  really_delete_cont(gens);
+
+  // Enumerate the semigroup first so that P uses the Cayley graphs of S
+  REQUIRE(S.size() == 88);
+
+  std::vector<relation_t> extra(
+      {relation_t({0, 1, 0, 0, 0, 1, 1, 0, 0}, {1, 0, 0, 0, 1})});
+
+  Congruence cong1("twosided", &S, extra);
+  cong1.set_report(P_REPORT);
+  cong1.force_p();
+  REQUIRE(cong1.test_equals({0, 0, 0, 1}, {0, 0, 1, 0, 0}));
+  REQUIRE(cong1.nr_classes() == 21);
+  REQUIRE(cong1.word_to_class_index({0, 0, 0, 1})
+          == cong1.word_to_class_index({0, 0, 1, 0, 0}));
+
+  Congruence cong2("left", &S, extra);
+  cong2.set_report(P_REPORT);
+  cong2.force_p();
+  REQUIRE(cong2.nr_classes() == 69);
+  REQUIRE(cong2.word_to_class_index({0, 0, 0, 1})
+          != cong2.word_to_class_index({0, 0, 1, 0, 0}));
+
+  Congruence cong3("right", &S, extra);
+  cong3.set_report(P_REPORT);
+  cong3.force_p();
+  REQUIRE(cong3.nr_classes() == 72);
+  REQUIRE(cong3.word_to_class_index({0, 0, 0, 1})
+          != cong3.word_to_class_index({0, 0, 1, 0, 0}));
+}
+
+TEST_CASE("P 12: nontrivial classes on enumerated finite semigroup",
+          "[quick][congruence][p][finite][12]") {
+  std::vector<Element*> gens = {new Transformation<u_int16_t>({1, 3, 4, 2, 3}),
+                                new Transformation<u_int16_t>({3, 2, 1, 3, 3})};
+  Semigroup<>           S    = Semigroup<>(gens);
+  S.set_report(P_REPORT);
+  really_delete_cont(gens);
+  REQUIRE(S.size() == 88);
+
+  std::vector<relation_t> extra(
+      {relation_t({0, 1, 0, 0, 0, 1, 1, 0, 0}, {1, 0, 0, 0, 1})});
+
+  Congruence cong1("twosided", &S, extra);
+  cong1.set_report(P_REPORT);
+  cong1.force_p();
+  Partition<word_t>* ntc1 = cong1.nontrivial_classes();
+
+  Congruence cong2("twosided", &S, extra);
+  cong2.set_report(P_REPORT);
+  cong2.force_tc_prefill();
+  Partition<word_t>* ntc2 = cong2.nontrivial_classes();
+
+  REQUIRE(ntc1->size() == ntc2->size());
+  size_t nr_elms = 0;
+  for (size_t i = 0; i < ntc1->size(); i++) {
+    REQUIRE(ntc1->at(i)->size() > 1);
+    nr_elms += ntc1->at(i)->size();
+    for (word_t* w : *ntc1->at(i)) {
+      REQUIRE(cong1.word_to_class_index(*w)
+              == cong1.word_to_class_index(*ntc1->at(i, 0)));
+      REQUIRE(cong2.word_to_class_index(*w)
+              == cong2.word_to_class_index(*ntc1->at(i, 0)));
+    }
+  }
+  REQUIRE(nr_elms == 88 - 21 + ntc1->size());
+  delete ntc1;
+  delete ntc2;
+}
+
+TEST_CASE("P 13: congruences on enumerated big finite semigroup",
+          "[quick][congruence][p][finite][13]") {
+  std::vector<Element*> gens
+      = {new Transformation<u_int16_t>({7, 3, 5, 3, 4, 2, 7, 7}),
+         new Transformation<u_int16_t>({1, 2, 4, 4, 7, 3, 0, 7}),
+         new Transformation<u_int16_t>({0, 6, 4, 2, 2, 6, 6, 4}),
+         new Transformation<u_int16_t>({3, 6, 3, 4, 0, 6, 0, 7})};
+  Semigroup<> S = Semigroup<>(gens);
+  S.set_report(P_REPORT);
+  really_delete_cont(gens);
+  REQUIRE(S.size() == 11804);
+
+  std::vector<relation_t> extra(
+      {relation_t({0, 3, 2, 1, 3, 2, 2}, {3, 2, 2, 1, 3, 3})});
+  Congruence cong1("twosided", &S, extra);
+  cong1.set_report(P_REPORT);
+  cong1.force_p();
+  REQUIRE(cong1.nr_classes() == 525);
+  REQUIRE(cong1.word_to_class_index({1, 2, 1, 3, 3, 2, 1, 2})
+          == cong1.word_to_class_index({2, 1, 3, 3, 2, 1, 0}));
+  REQUIRE(cong1.word_to_class_index({0, 3, 2, 1, 3, 3, 3})
+          != cong1.word_to_class_index({0, 0, 3}));
+
+  Congruence cong2("left", &S, extra);
+  cong2.set_report(P_REPORT);
+  cong2.force_p();
+  REQUIRE(cong2.nr_classes() == 7449);
+  REQUIRE(cong2.word_to_class_index({1, 1, 3, 2, 2, 1, 3, 1, 3, 3})
+          == cong2.word_to_class_index({2, 2, 0, 1}));
+  REQUIRE(cong2.word_to_class_index({1, 1, 0, 3})
+          != cong2.word_to_class_index({1, 0, 3, 2, 0, 2, 0, 3, 2, 2, 1}));
+
+  extra = {relation_t({1, 3, 0, 1, 2, 2, 0, 2}, {1, 0, 0, 1, 3, 1})};
+  Congruence cong3("twosided", &S, extra);
+  cong3.set_report(P_REPORT);
+  cong3.force_p();
+  REQUIRE(cong3.nr_classes() == 9597);
+  REQUIRE(cong3.word_to_class_index({3, 0, 2, 0, 2, 0, 2})
+          == cong3.word_to_class_index({1, 2, 3, 1, 2}));
+}
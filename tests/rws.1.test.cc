@@ -851,7 +851,7 @@ TEST_CASE("RWS 42: Example 6.6 in Sims (with limited overlap lengths)",
 // introducing new generators for the PCP generators.
 /*TEST_CASE("RWS 43: (from kbmag/standalone/kb_data/heinnilp)",
           "[fails][rws][kbmag][recursive][43]") {
-  // FIXME fails because internal_rewrite expect rules to be length reducing
+  // FIXME does not terminate in a reasonable amount of time
   RWS rws(new RECURSIVE(), "fFyYdDcCbBaA");
   rws.add_rule("BAba", "c");
   rws.add_rule("CAca", "d");
@@ -997,7 +997,7 @@ TEST_CASE("RWS 49: (from kbmag/standalone/kb_data/s4)",
 // by first applying the NQA to find the maximal nilpotent quotient, and then
 // introducing new generators for the PCP generators. It is essential for
 // success that reasonably low values of the maxstoredlen parameter are given.
-/*TEST_CASE("RWS 50: (from kbmag/standalone/kb_data/verifynilp)",
+TEST_CASE("RWS 50: (from kbmag/standalone/kb_data/verifynilp)",
           "[quick][rws][kbmag][recursive][50]") {
   RWS rws(new RECURSIVE(), "hHgGfFyYdDcCbBaA");
   rws.add_rule("BAba", "c");
@@ -1026,4 +1026,4 @@ TEST_CASE("RWS 49: (from kbmag/standalone/kb_data/s4)",
   REQUIRE(rws.rule("GBgb", "h"));
   REQUIRE(rws.rule("cb", "bc"));
   REQUIRE(rws.rule("ya", "ay"));
-}*/
+}
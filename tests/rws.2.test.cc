@@ -18,6 +18,7 @@
 // TODO The other examples from Sims book (Chapters 5 and 6) which use
 // reduction orderings different from shortlex
 
+#include <algorithm>
 #include <utility>
 
 #include "catch.hpp"
@@ -178,7 +179,7 @@ TEST_CASE("RWS 56: (from kbmag/standalone/kb_data/f2)",
 }
 
 //  A nonhopfian group
-/*TEST_CASE("RWS 57: (from kbmag/standalone/kb_data/nonhopf)",
+TEST_CASE("RWS 57: (from kbmag/standalone/kb_data/nonhopf)",
           "[quick][rws][kbmag][recursive][57]") {
   RWS rws(new RECURSIVE(), "aAbB");
   rws.add_rule("Baab", "aaa");
@@ -191,7 +192,7 @@ TEST_CASE("RWS 56: (from kbmag/standalone/kb_data/f2)",
   REQUIRE(rws.nr_rules() == 1);
 
   REQUIRE(rws.rule("Baab", "aaa"));
-}*/
+}
 
 // Symmetric group S_16
 // knuth_bendix/2 fail to terminate
@@ -486,7 +487,7 @@ TEST_CASE("RWS 65: (from kbmag/standalone/kb_data/degen4b)",
 }
 
 // Free nilpotent group of rank 2 and class 2
-/*TEST_CASE("RWS 66: (from kbmag/standalone/kb_data/nilp2)",
+TEST_CASE("RWS 66: (from kbmag/standalone/kb_data/nilp2)",
           "[quick][rws][kbmag][recursive][66]") {
   RWS rws(new RECURSIVE(), "cCbBaA");
   rws.add_rule("ba", "abc");
@@ -502,7 +503,7 @@ TEST_CASE("RWS 65: (from kbmag/standalone/kb_data/degen4b)",
   REQUIRE(rws.nr_rules() == 3);
   // FIXME KBMAG says this terminates with 32758 rules, maybe that was with
   // shortlex order?
-}*/
+}
 
 // knuth_bendix/2 don't finish
 TEST_CASE("RWS 67: (from kbmag/standalone/kb_data/funny3)",
@@ -639,7 +640,7 @@ TEST_CASE("RWS 72: (from kbmag/standalone/kb_data/c2)",
   REQUIRE(rws.rule("aa", ""));
 }
 
-/*TEST_CASE("RWS 73: (from kbmag/standalone/kb_data/freenilpc3)",
+TEST_CASE("RWS 73: (from kbmag/standalone/kb_data/freenilpc3)",
           "[quick][rws][kbmag][recursive][73]") {
   RWS rws(new RECURSIVE(), "yYdDcCbBaA");
   rws.add_rule("BAba", "c");
@@ -664,7 +665,7 @@ TEST_CASE("RWS 72: (from kbmag/standalone/kb_data/c2)",
   REQUIRE(rws.rule("ya", "ay"));
   REQUIRE(rws.rule("db", "bd"));
   REQUIRE(rws.rule("yb", "by"));
-}*/
+}
 
 // The group is S_4, and the subgroup H of order 4. There are 30 reduced words -
 // 24 for the group elements, and 6 for the 6 cosets Hg.
@@ -917,3 +918,320 @@ TEST_CASE("RWS 84: set_max_overlap", "[quick][rws][84]") {
   rws.set_max_overlap(10);
   rws.set_max_overlap(-11);
 }
+
+TEST_CASE("RWS 85: rewriting with non-reduced rules", "[quick][rws][85]") {
+  RWS rws;
+  rws.add_rule("ab", "");
+  rws.add_rule("cabd", "c");
+  REQUIRE(rws.nr_rules() == 2);
+
+  REQUIRE(rws.rewrite("cabd") == "cd");
+  REQUIRE(rws.rewrite("xcabdyab") == "xcdy");
+  REQUIRE(rws.rewrite("aaabbb") == "");
+  REQUIRE(rws.rewrite("dcdcab") == "dcdc");
+
+  // ab is a suffix of dcab, and so dcab -> a is reduced to dc -> a
+  rws.add_rule("dcab", "a");
+  REQUIRE(rws.nr_rules() == 3);
+  REQUIRE(rws.rule("dc", "a"));
+  REQUIRE(rws.rewrite("dcab") == "a");
+
+  rws.knuth_bendix();
+  REQUIRE(rws.confluent());
+  REQUIRE(rws.test_equals("cd", "c"));
+  REQUIRE(rws.test_equals("dcabab", "a"));
+  REQUIRE(!rws.test_equals("cd", "d"));
+}
+
+TEST_CASE("RWS 86: knuth_bendix with multiple threads",
+          "[quick][rws][fpsemigroup][86]") {
+  RWS rws1;
+  RWS rws2;
+  for (RWS* rws : {&rws1, &rws2}) {
+    rws->set_report(RWS_REPORT);
+    rws->add_rule("aa", "");
+    rws->add_rule("bc", "");
+    rws->add_rule("bbb", "");
+    rws->add_rule("ababababababab", "");
+    rws->add_rule("abacabacabacabac", "");
+  }
+  rws2.set_max_threads(4);
+  rws1.knuth_bendix();
+  rws2.knuth_bendix();
+  REQUIRE(rws2.confluent());
+  REQUIRE(rws2.nr_rules() == 40);
+  // The left hand sides of the rules of a confluent system are determined
+  // by the ordering, but the right hand sides are not necessarily reduced.
+  std::vector<std::pair<std::string, std::string>> rules1 = rws1.rules();
+  std::vector<std::pair<std::string, std::string>> rules2 = rws2.rules();
+  REQUIRE(rules1.size() == rules2.size());
+  for (size_t i = 0; i < rules1.size(); ++i) {
+    REQUIRE(rules1[i].first == rules2[i].first);
+    REQUIRE(rws1.rewrite(rules1[i].second) == rws2.rewrite(rules2[i].second));
+  }
+  REQUIRE(rws1.rewrite("abacbcabbacab") == rws2.rewrite("abacbcabbacab"));
+}
+
+// Returns true if p is greater than q in the recursive path ordering, as in
+// Definition 1.2.14 of "Confluent String Rewriting" by Matthias Jantzen.
+static bool recursive_path_ordering(std::string const& p,
+                                    std::string const& q) {
+  if (p.empty()) {
+    return false;
+  } else if (q.empty()) {
+    return true;
+  }
+  std::string u(p, 0, p.size() - 1);
+  std::string v(q, 0, q.size() - 1);
+  char        a = p.back();
+  char        b = q.back();
+  if (u == q || recursive_path_ordering(u, q)) {
+    return true;
+  } else if (a > b) {
+    return recursive_path_ordering(p, v);
+  } else if (a == b) {
+    return recursive_path_ordering(u, v);
+  }
+  return false;
+}
+
+TEST_CASE("RWS 87: RECURSIVE ordering and non-length reducing rules",
+          "[quick][rws][recursive][87]") {
+  RECURSIVE order;
+  std::string p = "b", q = "a";
+  REQUIRE(order(p, q));
+  REQUIRE(!order(q, p));
+  REQUIRE(order(q, ""));
+  p = "ab", q = "ba";
+  REQUIRE(order(p, q));
+  REQUIRE(!order(q, p));
+  REQUIRE(!order(p, p));
+  // Not length reducing
+  q = "baa";
+  REQUIRE(order(p, q));
+  q = "aaab";
+  REQUIRE(order("bb", q));
+
+  // Compare with the definition for all words of length at most 5 over 3
+  // letters.
+  std::vector<std::string> words = {""};
+  for (size_t i = 0; i < words.size(); ++i) {
+    if (words[i].size() < 5) {
+      for (char x : {'a', 'b', 'c'}) {
+        words.push_back(words[i] + x);
+      }
+    }
+  }
+  REQUIRE(words.size() == 364);
+  size_t nr_disagree = 0;
+  for (auto const& u : words) {
+    for (auto const& v : words) {
+      if (order(u, v) != recursive_path_ordering(u, v)) {
+        nr_disagree++;
+      }
+    }
+  }
+  REQUIRE(nr_disagree == 0);
+
+  // The free nilpotent monoid of rank 2 and class 2, where c = [b, a] is
+  // central, and so b ^ m a ^ n = a ^ n b ^ m c ^ (mn).
+  RWS rws(new RECURSIVE(), "cba");
+  rws.add_rule("ba", "abc");
+  rws.add_rule("ca", "ac");
+  rws.add_rule("cb", "bc");
+  REQUIRE(rws.confluent());
+  REQUIRE(rws.rule("ba", "abc"));
+
+  REQUIRE(rws.rewrite("bbaa") == "aabbcccc");
+  REQUIRE(rws.rewrite(std::string(8, 'b') + std::string(8, 'a'))
+          == std::string(8, 'a') + std::string(8, 'b') + std::string(64, 'c'));
+  REQUIRE(rws.rewrite(std::string(40, 'b') + std::string(40, 'a'))
+          == std::string(40, 'a') + std::string(40, 'b')
+                 + std::string(1600, 'c'));
+}
+
+TEST_CASE("RWS 88: normal forms", "[quick][rws][88]") {
+  RWS rws("ab");
+  REQUIRE(rws.nr_normal_forms(0, 4) == 15);
+  REQUIRE(rws.nr_normal_forms(3, 4) == 8);
+  REQUIRE(rws.nr_normal_forms(0, RWS::UNBOUNDED) == RWS::UNBOUNDED);
+
+  // The bicyclic monoid, whose normal forms are b ^ i a ^ j.
+  rws.add_rule("ab", "");
+  REQUIRE(rws.nr_normal_forms(0, 5) == 15);
+  REQUIRE(rws.nr_normal_forms(4, 5) == 5);
+  REQUIRE(rws.nr_normal_forms(0, RWS::UNBOUNDED) == RWS::UNBOUNDED);
+  REQUIRE(rws.nr_normal_forms(5, RWS::UNBOUNDED) == RWS::UNBOUNDED);
+  REQUIRE(rws.is_reduced("bbbaa"));
+  REQUIRE(!rws.is_reduced("bbaba"));
+  REQUIRE(rws.is_reduced(""));
+
+  std::vector<std::string> nfs;
+  rws.normal_forms(0, 3, [&nfs](std::string const& w) {
+    nfs.push_back(w);
+    return true;
+  });
+  REQUIRE(nfs
+          == std::vector<std::string>({"", "a", "b", "aa", "ba", "bb"}));
+  nfs.clear();
+  rws.normal_forms(3, RWS::UNBOUNDED, [&nfs](std::string const& w) {
+    nfs.push_back(w);
+    return nfs.size() < 6;
+  });
+  REQUIRE(nfs
+          == std::vector<std::string>({"aaa", "baa", "bba", "bbb", "aaaa",
+                                       "baaa"}));
+}
+
+TEST_CASE("RWS 89: normal forms of a finite monoid", "[quick][rws][89]") {
+  // The symmetric group of degree 3, with the generators in the reverse
+  // order.
+  RWS rws("ba");
+  rws.add_rule("aa", "");
+  rws.add_rule("bbb", "");
+  rws.add_rule("abab", "");
+  REQUIRE(rws.nr_normal_forms(0, RWS::UNBOUNDED) == 6);
+  REQUIRE(rws.nr_normal_forms(1, RWS::UNBOUNDED) == 5);
+  REQUIRE(rws.nr_normal_forms(2, 3) == 3);
+  REQUIRE(rws.nr_normal_forms(4, RWS::UNBOUNDED) == 0);
+
+  std::vector<std::string> nfs;
+  rws.normal_forms(0, RWS::UNBOUNDED, [&nfs](std::string const& w) {
+    nfs.push_back(w);
+    return true;
+  });
+  REQUIRE(nfs
+          == std::vector<std::string>({"", "b", "a", "bb", "ba", "ab"}));
+  for (auto const& w : nfs) {
+    REQUIRE(rws.is_reduced(w));
+    REQUIRE(rws.rewrite(w) == w);
+  }
+  REQUIRE(!rws.is_reduced("aba"));
+
+  // A monoid with 4 generators and 24 elements
+  RWS rws2(new SHORTLEX(), "abcd");
+  rws2.add_rule("aa", "a");
+  rws2.add_rule("ad", "d");
+  rws2.add_rule("bb", "b");
+  rws2.add_rule("ca", "ac");
+  rws2.add_rule("cc", "c");
+  rws2.add_rule("da", "d");
+  rws2.add_rule("dc", "cd");
+  rws2.add_rule("dd", "d");
+  rws2.add_rule("aba", "a");
+  rws2.add_rule("bab", "b");
+  rws2.add_rule("bcb", "b");
+  rws2.add_rule("bcd", "cd");
+  rws2.add_rule("cbc", "c");
+  rws2.add_rule("cdb", "cd");
+  size_t nr = 0;
+  rws2.normal_forms(0, RWS::UNBOUNDED, [&rws2, &nr](std::string const& w) {
+    REQUIRE(rws2.rewrite(w) == w);
+    nr++;
+    return true;
+  });
+  REQUIRE(nr == 24);
+  REQUIRE(rws2.nr_normal_forms(0, RWS::UNBOUNDED) == 24);
+}
+
+TEST_CASE("RWS 90: confluent after adding and removing rules",
+          "[quick][rws][90]") {
+  RWS rws;
+  rws.set_report(RWS_REPORT);
+  rws.add_rule("aa", "");
+  rws.add_rule("bbb", "");
+  REQUIRE(rws.confluent());
+  rws.add_rule("abab", "");
+  REQUIRE(!rws.confluent());
+  rws.knuth_bendix();
+  REQUIRE(rws.confluent());
+  REQUIRE(rws.nr_normal_forms(0, RWS::UNBOUNDED) == 6);
+
+  // The next rule makes the left hand sides of some active rules reducible,
+  // and so they are removed and added again.
+  rws.add_rule("ab", "ba");
+  RWS copy;
+  for (auto const& rule : rws.rules()) {
+    copy.add_rule(rule.first, rule.second);
+  }
+  REQUIRE(rws.confluent() == copy.confluent());
+  rws.knuth_bendix();
+  REQUIRE(rws.confluent());
+  REQUIRE(rws.nr_normal_forms(0, RWS::UNBOUNDED) == 2);
+  REQUIRE(rws.rules()
+          == std::vector<std::pair<std::string, std::string>>(
+                 {{"b", ""}, {"aa", ""}}));
+}
+
+TEST_CASE("RWS 91: rewrite and test_equals for many words",
+          "[quick][rws][91]") {
+  RWS rws("ba");
+  rws.set_report(RWS_REPORT);
+  rws.set_max_threads(4);
+  rws.add_rule("aa", "");
+  rws.add_rule("bbb", "");
+  rws.add_rule("abab", "");
+
+  // All words of length at most 10 over {a, b}
+  std::vector<std::string> words = {""};
+  for (size_t i = 0; words.size() < 2047; ++i) {
+    words.push_back(words[i] + "a");
+    words.push_back(words[i] + "b");
+  }
+  std::vector<std::string> p(words.begin(), words.begin() + 1024);
+  std::vector<std::string> q(words.begin() + 1023, words.end());
+  std::vector<bool>        result = rws.test_equals(&p, &q);
+  REQUIRE(result.size() == 1024);
+  REQUIRE(std::count(result.cbegin(), result.cend(), true) > 0);
+  for (size_t i = 0; i < 1024; ++i) {
+    REQUIRE(result[i] == rws.test_equals(words[i], words[i + 1023]));
+    REQUIRE(p[i] == rws.rewrite(words[i]));
+    REQUIRE(q[i] == rws.rewrite(words[i + 1023]));
+  }
+
+  std::vector<std::string> copy(words);
+  rws.rewrite(&copy);
+  for (size_t i = 0; i < words.size(); ++i) {
+    REQUIRE(copy[i] == rws.rewrite(words[i]));
+  }
+
+  std::vector<relation_t> pairs;
+  for (size_t i = 0; i < 3000; ++i) {
+    pairs.emplace_back(word_t(i % 11, 0), word_t(i % 7, 1));
+    pairs.back().first.push_back(i % 2);
+  }
+  result = rws.test_equals(pairs);
+  REQUIRE(result.size() == 3000);
+  for (size_t i = 0; i < pairs.size(); ++i) {
+    REQUIRE(result[i] == rws.test_equals(pairs[i].first, pairs[i].second));
+  }
+}
+
+TEST_CASE("RWS 92: set_max_memory", "[quick][rws][92]") {
+  std::vector<std::vector<std::pair<std::string, std::string>>> rules;
+  for (size_t max_memory : {RWS::UNBOUNDED, size_t(0), size_t(4096)}) {
+    RWS rws;
+    rws.set_report(RWS_REPORT);
+    rws.set_max_memory(max_memory);
+    rws.add_rule("aa", "");
+    rws.add_rule("bc", "");
+    rws.add_rule("bbb", "");
+    rws.add_rule("ababababababab", "");
+    rws.add_rule("abacabacabacabac", "");
+    REQUIRE(!rws.confluent());
+
+    rws.knuth_bendix();
+    REQUIRE(rws.confluent());
+    REQUIRE(rws.nr_rules() == 40);
+    REQUIRE(rws.nr_normal_forms(0, RWS::UNBOUNDED) == 168);
+    rules.push_back(rws.rules());
+    for (auto& rule : rules.back()) {
+      rule.second = rws.rewrite(rule.second);
+    }
+    std::sort(rules.back().begin(), rules.back().end());
+  }
+  // The left hand sides of the rules of a confluent system, and the normal
+  // forms of their right hand sides, only depend on the ordering.
+  REQUIRE(rules[0] == rules[1]);
+  REQUIRE(rules[0] == rules[2]);
+}
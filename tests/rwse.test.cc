@@ -103,3 +103,51 @@ TEST_CASE("RWSE 02: factorisation", "[quick][rwse][02]") {
   aaa.really_delete();
   ab.really_delete();
 }
+
+TEST_CASE("RWSE 03: redefine after adding rules", "[quick][rwse][03]") {
+  RWS rws;
+  rws.add_rules({relation_t({0, 0, 0}, {0}),
+                 relation_t({1, 1}, {1}),
+                 relation_t({0, 1, 0, 1}, {0})});
+
+  std::vector<word_t> words = {word_t({0}),
+                               word_t({1}),
+                               word_t({0, 1}),
+                               word_t({1, 0}),
+                               word_t({0, 0, 1}),
+                               word_t({1, 0, 0, 1, 0}),
+                               word_t({0, 1, 1, 0, 1, 0, 0})};
+
+  std::vector<RWSE*> elts;
+  for (word_t const& w : words) {
+    elts.push_back(new RWSE(rws, w));
+  }
+  RWSE z(rws, 0);
+
+  // The rewriting system is not confluent, and so we compare the product of
+  // two elements with the reduction of the concatenation of their words.
+  auto check = [&elts, &rws, &z]() {
+    for (RWSE const* x : elts) {
+      for (RWSE const* y : elts) {
+        RWSE xy(rws, *x->get_rws_word() + *y->get_rws_word());
+        z.redefine(x, y);
+        REQUIRE(z == xy);
+        xy.really_delete();
+      }
+    }
+  };
+
+  check();
+  // The elements in elts are no longer necessarily reduced.
+  rws.add_rules({relation_t({1, 0, 1}, {1})});
+  check();
+  rws.knuth_bendix();
+  REQUIRE(rws.confluent());
+  check();
+
+  for (RWSE* x : elts) {
+    x->really_delete();
+    delete x;
+  }
+  z.really_delete();
+}
@@ -385,4 +385,134 @@ TEST_CASE("Semigroup 77: iterators BMat8", "[quick][semigroup][finite][77]") {
   }
   REQUIRE(pos == 0);
 }
+
+TEST_CASE("Semigroup 78: full PBR monoid on 2 points using BitPBR",
+          "[quick][semigroup][finite][pbr][78]") {
+  using adj_t = std::vector<std::vector<u_int32_t>>;
+  std::vector<Element*> gens = {new BitPBR(adj_t({{2}, {3}, {0}, {1}})),
+                                new BitPBR(adj_t({{}, {2}, {1}, {0, 3}})),
+                                new BitPBR(adj_t({{0, 3}, {2}, {1}, {}})),
+                                new BitPBR(adj_t({{1, 2}, {3}, {0}, {1}})),
+                                new BitPBR(adj_t({{2}, {3}, {0}, {1, 3}})),
+                                new BitPBR(adj_t({{3}, {1}, {0}, {1}})),
+                                new BitPBR(adj_t({{3}, {2}, {0}, {0, 1}})),
+                                new BitPBR(adj_t({{3}, {2}, {0}, {1}})),
+                                new BitPBR(adj_t({{3}, {2}, {0}, {3}})),
+                                new BitPBR(adj_t({{3}, {2}, {1}, {0}})),
+                                new BitPBR(adj_t({{3}, {2, 3}, {0}, {1}}))};
+  REQUIRE(gens[0]->degree() == 2);
+  Semigroup<> S(gens);
+  really_delete_cont(gens);
+  S.set_report(SEMIGROUPS_REPORT);
+  REQUIRE(S.size() == 65536);
+  REQUIRE(S.nrrules() == 45416);
+}
+
+TEST_CASE("Semigroup 79: small matrix semigroups over static semirings",
+          "[quick][semigroup][finite][79]") {
+  {
+    using Mat = StaticMatrixOverSemiring<StaticTropicalMaxPlusSemiring<33>>;
+    std::vector<Element*> gens
+        = {new Mat({{22, 21, 0}, {10, 0, 0}, {1, 32, 1}}),
+           new Mat({{0, 0, 0}, {0, 1, 0}, {1, 1, 0}})};
+    Semigroup<> S(gens);
+    really_delete_cont(gens);
+    S.set_report(SEMIGROUPS_REPORT);
+    REQUIRE(S.size() == 119);
+    REQUIRE(S.nridempotents() == 1);
+    REQUIRE(S.nrrules() == 18);
+  }
+  {
+    using Mat = StaticMatrixOverSemiring<StaticTropicalMinPlusSemiring<11>>;
+    std::vector<Element*> gens
+        = {new Mat({{2, 1, 0}, {10, 0, 0}, {1, 2, 1}}),
+           new Mat({{10, 0, 0}, {0, 1, 0}, {1, 1, 0}})};
+    Semigroup<> S(gens);
+    really_delete_cont(gens);
+    S.set_report(SEMIGROUPS_REPORT);
+    REQUIRE(S.size() == 1039);
+    REQUIRE(S.nridempotents() == 5);
+    REQUIRE(S.nrrules() == 38);
+  }
+  {
+    using Mat = StaticMatrixOverSemiring<StaticNaturalSemiring<11, 3>>;
+    std::vector<Element*> gens
+        = {new Mat({{2, 1, 0}, {10, 0, 0}, {1, 2, 1}}),
+           new Mat({{10, 0, 0}, {0, 1, 0}, {1, 1, 0}})};
+    Semigroup<> S(gens);
+    really_delete_cont(gens);
+    S.set_report(SEMIGROUPS_REPORT);
+    REQUIRE(S.size() == 86);
+    REQUIRE(S.nridempotents() == 10);
+    REQUIRE(S.nrrules() == 16);
+  }
+}
 #endif
+
+TEST_CASE("Semigroup 80: add_generators and closure increasing the degree",
+          "[quick][semigroup][finite][80]") {
+  {
+    std::vector<Element*> gens
+        = {new Transformation<u_int16_t>({0, 1, 2, 3, 4, 5}),
+           new Transformation<u_int16_t>({1, 0, 2, 3, 4, 5}),
+           new Transformation<u_int16_t>({4, 0, 1, 2, 3, 5}),
+           new Transformation<u_int16_t>({5, 1, 2, 3, 4, 5}),
+           new Transformation<u_int16_t>({1, 1, 2, 3, 4, 5})};
+    Semigroup<> S(gens);
+    S.set_report(SEMIGROUPS_REPORT);
+    REQUIRE(S.size() == 7776);
+
+    std::vector<Element*> coll
+        = {new Transformation<u_int16_t>({6, 0, 1, 2, 3, 5, 6})};
+    Semigroup<>* T = S.copy_add_generators(&coll);
+    T->set_report(SEMIGROUPS_REPORT);
+
+    S.add_generators(coll);
+    REQUIRE(S.degree() == 7);
+    REQUIRE(S.nrgens() == 6);
+    REQUIRE(S.size() == 16807);
+    REQUIRE(S.nridempotents() == 1358);
+    REQUIRE(S.nrrules() == T->nrrules());
+    REQUIRE(S.nrrules() == 7901);
+    Element* x = gens[2]->really_copy(1);
+    REQUIRE(S.position(x) == T->position(x));
+    REQUIRE(S.position(x) == 2);
+    REQUIRE(S.position(gens[2]) == Semigroup<>::UNDEFINED);
+    REQUIRE(*S.at(2) == *x);
+    x->really_delete();
+    delete x;
+
+    really_delete_cont(gens);
+    really_delete_cont(coll);
+    delete T;
+  }
+  {
+    std::vector<Element*> gens
+        = {new PartialPerm<u_int16_t>({0, 1, 2, 3}, {1, 2, 3, 0}, 4),
+           new PartialPerm<u_int16_t>({0, 1, 2, 3}, {1, 0, 2, 3}, 4),
+           new PartialPerm<u_int16_t>({1, 2, 3}, {1, 2, 3}, 4)};
+    Semigroup<> S(gens);
+    really_delete_cont(gens);
+    S.set_report(SEMIGROUPS_REPORT);
+    S.set_batch_size(10);
+    S.enumerate(10);
+    REQUIRE(!S.is_done());
+
+    std::vector<Element*> coll
+        = {new PartialPerm<u_int16_t>({0, 1, 2, 3, 4}, {1, 0, 2, 3, 4}, 5),
+           new PartialPerm<u_int16_t>({0, 1, 2, 3, 4}, {1, 2, 3, 4, 0}, 5),
+           new PartialPerm<u_int16_t>({1, 2, 3, 4}, {1, 2, 3, 4}, 5)};
+    S.closure(coll);
+    REQUIRE(S.degree() == coll[0]->degree());
+    really_delete_cont(coll);
+    REQUIRE(S.size() == 1546);
+    REQUIRE(S.nridempotents() == 32);
+    coll = {new PartialPerm<u_int16_t>({0, 1, 2, 3, 4}, {0, 1, 2, 3, 4}, 5),
+            new PartialPerm<u_int16_t>({0, 1, 2, 3}, {0, 1, 2, 3}, 5),
+            new PartialPerm<u_int16_t>({0, 1, 2, 3}, {0, 1, 2, 3}, 4)};
+    REQUIRE(S.test_membership(coll[0]));
+    REQUIRE(S.test_membership(coll[1]));
+    REQUIRE(!S.test_membership(coll[2]));
+    really_delete_cont(coll);
+  }
+}
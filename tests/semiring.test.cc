@@ -16,6 +16,10 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include "../src/semiring.h"
 #include "catch.hpp"
 
@@ -58,3 +62,82 @@ TEST_CASE("Semiring 03: boolean semiring", "[quick][semiring][03]") {
 
   delete sr;
 }
+
+// The product of the n x n matrices x and y over sr, computed entry by entry.
+static std::vector<int64_t> ijk_product(Semiring<int64_t> const*    sr,
+                                        std::vector<int64_t> const& x,
+                                        std::vector<int64_t> const& y,
+                                        size_t                      n) {
+  std::vector<int64_t> xy(n * n);
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      int64_t v = sr->zero();
+      for (size_t k = 0; k < n; k++) {
+        v = sr->plus(v, sr->prod(x[i * n + k], y[k * n + j]));
+      }
+      xy[i * n + j] = v;
+    }
+  }
+  return xy;
+}
+
+TEST_CASE("Semiring 04: matrix_product agrees with the ijk product",
+          "[quick][semiring][04]") {
+  std::vector<Semiring<int64_t>*> semirings
+      = {new Integers(),
+         new MaxPlusSemiring(),
+         new MinPlusSemiring(),
+         new TropicalMaxPlusSemiring(13),
+         new TropicalMinPlusSemiring(9),
+         new NaturalSemiring(3, 5)};
+  std::mt19937                           gen(1);
+  std::uniform_int_distribution<int64_t> dist(-2, 11);
+
+  for (Semiring<int64_t>* sr : semirings) {
+    for (size_t n : {1, 3, 8, 17}) {
+      std::vector<int64_t> x(n * n), y(n * n);
+      for (size_t i = 0; i < n * n; i++) {
+        // Only entries that belong to every semiring are used, negative
+        // values are replaced by the zero of the semiring.
+        int64_t a = dist(gen), b = dist(gen);
+        x[i]      = (a < 0 ? sr->zero() : std::min(a, int64_t(7)));
+        y[i]      = (b < 0 ? sr->zero() : std::min(b, int64_t(7)));
+      }
+      std::vector<int64_t> result(n * n, 42);
+      sr->matrix_product(x, y, result, n);
+      REQUIRE(result == ijk_product(sr, x, y, n));
+    }
+    delete sr;
+  }
+}
+
+TEST_CASE("Semiring 05: matrix_product of some 2 x 2 matrices",
+          "[quick][semiring][05]") {
+  int64_t const        ninf = Semiring<int64_t>::MINUS_INFTY;
+  int64_t const        inf  = Semiring<int64_t>::INFTY;
+  std::vector<int64_t> xy(4);
+
+  Integers ints;
+  ints.matrix_product({1, 2, 3, 4}, {5, 6, 7, 8}, xy, 2);
+  REQUIRE(xy == std::vector<int64_t>({19, 22, 43, 50}));
+
+  MaxPlusSemiring maxplus;
+  maxplus.matrix_product({1, ninf, 3, 4}, {5, 6, ninf, 8}, xy, 2);
+  REQUIRE(xy == std::vector<int64_t>({6, 7, 8, 12}));
+
+  MinPlusSemiring minplus;
+  minplus.matrix_product({1, inf, 3, 4}, {5, 6, inf, 8}, xy, 2);
+  REQUIRE(xy == std::vector<int64_t>({6, 7, 8, 9}));
+
+  TropicalMaxPlusSemiring tmaxplus(10);
+  tmaxplus.matrix_product({1, ninf, 3, 4}, {5, 6, ninf, 8}, xy, 2);
+  REQUIRE(xy == std::vector<int64_t>({6, 7, 8, 10}));
+
+  TropicalMinPlusSemiring tminplus(7);
+  tminplus.matrix_product({1, inf, 3, 4}, {5, 6, inf, 7}, xy, 2);
+  REQUIRE(xy == std::vector<int64_t>({6, 7, 7, 7}));
+
+  NaturalSemiring nat(3, 5);
+  nat.matrix_product({1, 2, 3, 4}, {0, 1, 2, 3}, xy, 2);
+  REQUIRE(xy == std::vector<int64_t>({4, 7, 3, 5}));
+}
@@ -0,0 +1,132 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <random>
+
+#include "../src/semigroups.h"
+#include "../src/smallbipart.h"
+#include "catch.hpp"
+
+#define SMALLBIPART_REPORT false
+
+using namespace libsemigroups;
+
+// Returns a random bipartition of degree n, in the form required by the
+// constructors of Bipartition and SmallBipartition.
+static std::vector<u_int32_t> random_blocks(size_t n, std::mt19937& gen) {
+  std::uniform_int_distribution<u_int32_t> dist(0, n);
+  std::vector<u_int32_t>                   blocks(2 * n);
+  std::vector<u_int32_t>                   lookup(n + 1, -1);
+  u_int32_t                                next = 0;
+  for (size_t i = 0; i < 2 * n; i++) {
+    u_int32_t b = dist(gen);
+    if (lookup[b] == static_cast<u_int32_t>(-1)) {
+      lookup[b] = next++;
+    }
+    blocks[i] = lookup[b];
+  }
+  return blocks;
+}
+
+TEST_CASE("SmallBipartition 01: methods", "[quick][smallbipart][01]") {
+  SmallBipartition<32> x({0, 1, 2, 1, 0, 2, 1, 0, 2, 2, 0, 0, 2, 0, 3, 4, 4,
+                          1, 3, 0});
+  SmallBipartition<32> y({0, 1, 1, 1, 1, 2, 3, 2, 4, 5, 5, 2, 4, 2, 1, 1, 1,
+                          2, 3, 2});
+  REQUIRE(x.degree() == 10);
+  REQUIRE(x.nr_blocks() == 5);
+  REQUIRE(y.nr_blocks() == 6);
+  REQUIRE(x != y);
+  REQUIRE(!(x == y));
+  REQUIRE(y < x);
+  REQUIRE(!(x < y));
+
+  SmallBipartition<32> xy = x * y;
+  REQUIRE(xy
+          == SmallBipartition<32>(
+                 {0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 1, 1, 1}));
+  REQUIRE(xy.nr_blocks() == 2);
+
+  SmallBipartition<32> id = x.one();
+  REQUIRE(id.degree() == 10);
+  REQUIRE(id.nr_blocks() == 10);
+  REQUIRE(id * x == x);
+  REQUIRE(x * id == x);
+  REQUIRE(x[0] == 0);
+  REQUIRE(x[19] == 0);
+  REQUIRE(x[15] == 4);
+
+  SmallBipartition<32> z(x);
+  REQUIRE(z == x);
+  REQUIRE(std::hash<SmallBipartition<32>>()(z)
+          == std::hash<SmallBipartition<32>>()(x));
+}
+
+TEST_CASE("SmallBipartition 02: products agree with Bipartition",
+          "[quick][smallbipart][02]") {
+  std::mt19937 gen(1);
+  for (size_t n : {1, 2, 5, 17, 32, 50, 64}) {
+    for (size_t k = 0; k < 50; k++) {
+      std::vector<u_int32_t> xblocks = random_blocks(n, gen);
+      std::vector<u_int32_t> yblocks = random_blocks(n, gen);
+
+      Bipartition x(xblocks);
+      Bipartition y(yblocks);
+      Bipartition xy(n);
+      xy.redefine(&x, &y, 0);
+
+      SmallBipartition<64> sx(xblocks);
+      SmallBipartition<64> sy(yblocks);
+      SmallBipartition<64> sxy = sx * sy;
+      REQUIRE(sxy.degree() == n);
+      REQUIRE(sxy.nr_blocks() == xy.nr_blocks());
+      for (size_t i = 0; i < 2 * n; i++) {
+        REQUIRE(sxy[i] == xy[i]);
+      }
+      REQUIRE(sxy == SmallBipartition<64>(std::vector<u_int32_t>(
+                         xy.begin(), xy.end())));
+      REQUIRE((x < y) == (sx < sy));
+
+      x.really_delete();
+      y.really_delete();
+      xy.really_delete();
+    }
+  }
+}
+
+TEST_CASE("SmallBipartition 03: partition monoid of degree 5",
+          "[quick][smallbipart][semigroup][03]") {
+  Semigroup<SmallBipartition<8>> S(
+      {SmallBipartition<8>({0, 1, 2, 3, 4, 4, 0, 1, 2, 3}),
+       SmallBipartition<8>({0, 1, 2, 3, 4, 1, 0, 2, 3, 4}),
+       SmallBipartition<8>({0, 1, 2, 3, 4, 5, 1, 2, 3, 4}),
+       SmallBipartition<8>({0, 0, 1, 2, 3, 0, 0, 1, 2, 3})});
+  S.set_report(SMALLBIPART_REPORT);
+  REQUIRE(S.size() == 115975);
+
+  std::vector<Element*> gens
+      = {new Bipartition({0, 1, 2, 3, 4, 4, 0, 1, 2, 3}),
+         new Bipartition({0, 1, 2, 3, 4, 1, 0, 2, 3, 4}),
+         new Bipartition({0, 1, 2, 3, 4, 5, 1, 2, 3, 4}),
+         new Bipartition({0, 0, 1, 2, 3, 0, 0, 1, 2, 3})};
+  Semigroup<> T(gens);
+  really_delete_cont(gens);
+  T.set_report(SMALLBIPART_REPORT);
+  REQUIRE(S.nrrules() == T.nrrules());
+  REQUIRE(S.nridempotents() == T.nridempotents());
+}
@@ -0,0 +1,154 @@
+//
+// libsemigroups - C++ library for semigroups and monoids
+// Copyright (C) 2018 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <algorithm>
+#include <random>
+
+#include "../src/semigroups.h"
+#include "../src/smallpperm.h"
+#include "catch.hpp"
+
+#define SMALLPPERM_REPORT false
+
+using namespace libsemigroups;
+
+static u_int32_t const UNDEF = PartialPerm<u_int32_t>::UNDEFINED;
+
+// Returns a random partial permutation of degree n, in the form required by
+// the constructors of PartialPerm and SmallPartialPerm.
+static std::vector<u_int32_t> random_images(size_t n, std::mt19937& gen) {
+  std::vector<u_int32_t> images(n);
+  for (size_t i = 0; i < n; i++) {
+    images[i] = i;
+  }
+  std::shuffle(images.begin(), images.end(), gen);
+  std::uniform_int_distribution<size_t> dist(0, 3);
+  for (size_t i = 0; i < n; i++) {
+    if (dist(gen) == 0) {
+      images[i] = UNDEF;
+    }
+  }
+  return images;
+}
+
+TEST_CASE("SmallPartialPerm 01: methods", "[quick][smallpperm][01]") {
+  SmallPartialPerm<16> x({4, UNDEF, 0, 3, UNDEF, 1});
+  SmallPartialPerm<16> y({0, 2, 5}, {1, 0, 3}, 6);
+  REQUIRE(x.degree() == 6);
+  REQUIRE(y.degree() == 6);
+  REQUIRE(x.rank() == 4);
+  REQUIRE(y.rank() == 3);
+  REQUIRE(x.domain_mask() == 0x2d);
+  REQUIRE(x.image_mask() == 0x1b);
+  REQUIRE(y.domain_mask() == 0x25);
+  REQUIRE(y.image_mask() == 0xb);
+  REQUIRE(x[1] == SmallPartialPerm<16>::UNDEFINED);
+  REQUIRE(x[5] == 1);
+  REQUIRE(x != y);
+  REQUIRE(y < x);
+  REQUIRE(!(x < y));
+
+  SmallPartialPerm<16> xy = x * y;
+  REQUIRE(xy == SmallPartialPerm<16>({UNDEF, UNDEF, 1, UNDEF, UNDEF, UNDEF}));
+  REQUIRE(xy.rank() == 1);
+  REQUIRE(xy.domain_mask() == 0x4);
+  REQUIRE(xy.image_mask() == 0x2);
+
+  SmallPartialPerm<16> id = x.one();
+  REQUIRE(id.rank() == 6);
+  REQUIRE(id * x == x);
+  REQUIRE(x * id == x);
+  REQUIRE(x * x.inverse() == SmallPartialPerm<16>({0, UNDEF, 2, 3, UNDEF, 5}));
+  REQUIRE(x.inverse().inverse() == x);
+  REQUIRE(x.inverse().domain_mask() == x.image_mask());
+
+  SmallPartialPerm<16> z(x);
+  REQUIRE(z == x);
+  REQUIRE(std::hash<SmallPartialPerm<16>>()(z)
+          == std::hash<SmallPartialPerm<16>>()(x));
+
+  SmallPartialPerm<64> w(std::vector<u_int32_t>(64, UNDEF));
+  REQUIRE(w.rank() == 0);
+  REQUIRE(w.one().rank() == 64);
+  REQUIRE(w.one().domain_mask() == 0xffffffffffffffff);
+}
+
+TEST_CASE("SmallPartialPerm 02: agrees with PartialPerm",
+          "[quick][smallpperm][02]") {
+  std::mt19937 gen(1);
+  for (size_t n : {1, 2, 5, 17, 32, 50, 64}) {
+    for (size_t k = 0; k < 50; ++k) {
+      std::vector<u_int32_t> ximages = random_images(n, gen);
+      std::vector<u_int32_t> yimages = random_images(n, gen);
+
+      PartialPerm<u_int32_t> x(ximages);
+      PartialPerm<u_int32_t> y(yimages);
+      PartialPerm<u_int32_t> xy(std::vector<u_int32_t>(n, 0));
+      xy.redefine(&x, &y);
+
+      SmallPartialPerm<64> sx(ximages);
+      SmallPartialPerm<64> sy(yimages);
+      SmallPartialPerm<64> sxy = sx * sy;
+      REQUIRE(sxy.degree() == n);
+      REQUIRE(sxy.rank() == xy.crank());
+      REQUIRE(sx.rank() == x.crank());
+      uint64_t dom = 0;
+      uint64_t ran = 0;
+      for (size_t i = 0; i < n; ++i) {
+        if (xy[i] == UNDEF) {
+          REQUIRE(sxy[i] == SmallPartialPerm<64>::UNDEFINED);
+        } else {
+          REQUIRE(sxy[i] == xy[i]);
+          dom |= uint64_t(1) << i;
+          ran |= uint64_t(1) << xy[i];
+        }
+      }
+      REQUIRE(sxy.domain_mask() == dom);
+      REQUIRE(sxy.image_mask() == ran);
+      REQUIRE((x < y) == (sx < sy));
+      REQUIRE((y < x) == (sy < sx));
+      REQUIRE((x < xy) == (sx < sxy));
+
+      x.really_delete();
+      y.really_delete();
+      xy.really_delete();
+    }
+  }
+}
+
+TEST_CASE("SmallPartialPerm 03: symmetric inverse monoid of degree 6",
+          "[quick][smallpperm][semigroup][03]") {
+  std::vector<std::vector<u_int32_t>> gens = {{1, 0, 2, 3, 4, 5},
+                                              {1, 2, 3, 4, 5, 0},
+                                              {UNDEF, 1, 2, 3, 4, 5}};
+  Semigroup<SmallPartialPerm<8>> S({SmallPartialPerm<8>(gens[0]),
+                                    SmallPartialPerm<8>(gens[1]),
+                                    SmallPartialPerm<8>(gens[2])});
+  S.set_report(SMALLPPERM_REPORT);
+  REQUIRE(S.size() == 13327);
+
+  std::vector<Element*> elts = {new PartialPerm<u_int32_t>(gens[0]),
+                                new PartialPerm<u_int32_t>(gens[1]),
+                                new PartialPerm<u_int32_t>(gens[2])};
+  Semigroup<>           T(elts);
+  really_delete_cont(elts);
+  T.set_report(SMALLPPERM_REPORT);
+  REQUIRE(S.nrrules() == T.nrrules());
+  REQUIRE(S.nridempotents() == T.nridempotents());
+  REQUIRE(S.nridempotents() == 64);
+}
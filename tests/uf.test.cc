@@ -19,6 +19,7 @@
 // The purpose of this file is to test the UF class which describes a partition
 // of the set of integers {0 .. n-1}
 
+#include <thread>
 #include <utility>
 
 #include "../src/uf.h"
@@ -228,3 +229,146 @@ TEST_CASE("UF 15: join", "[quick][uf][15]") {
   REQUIRE(uf1.next_rep() == 6);
   REQUIRE(uf1.next_rep() == 8);
 }
+
+TEST_CASE("UF 16: ConcurrentUF find and unite", "[quick][uf][16]") {
+  ConcurrentUF<> uf(10);
+  REQUIRE(uf.get_size() == 10);
+  REQUIRE(uf.nr_blocks() == 10);
+  REQUIRE(uf.get_table() == UF::table_t({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  REQUIRE(uf.unite(3, 5));
+  REQUIRE(uf.unite(9, 5));
+  REQUIRE(!uf.unite(5, 9));
+  REQUIRE(uf.unite(8, 7));
+  REQUIRE(uf.find(9) == 3);
+  REQUIRE(uf.find(8) == 7);
+  REQUIRE(uf.find_and_halve(5) == 3);
+  REQUIRE(uf.same_block(5, 9));
+  REQUIRE(!uf.same_block(5, 7));
+  REQUIRE(uf.nr_blocks() == 7);
+  REQUIRE(uf.get_table() == UF::table_t({0, 1, 2, 3, 4, 3, 6, 7, 7, 3}));
+
+  UF uf2(uf.get_table());
+  REQUIRE(uf2.nr_blocks() == 7);
+}
+
+TEST_CASE("UF 17: ConcurrentUF constructor by table", "[quick][uf][17]") {
+  ConcurrentUF<size_t> uf(UF::table_t({0, 0, 2, 1, 2, 5, 6, 7, 8, 8, 4, 9}));
+  REQUIRE(uf.nr_blocks() == 6);
+  REQUIRE(uf.find(3) == 0);
+  REQUIRE(uf.find(10) == 2);
+  REQUIRE(uf.find(11) == 8);
+  REQUIRE(uf.unite(11, 6));
+  REQUIRE(uf.find(8) == 6);
+  REQUIRE(uf.nr_blocks() == 5);
+}
+
+TEST_CASE("UF 18: ConcurrentUF big chain in several threads",
+          "[quick][uf][18]") {
+  size_t                   n = 100000;
+  ConcurrentUF<>           uf(n);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&uf, n, t]() {
+      for (size_t i = t; i < n - 1; i += 4) {
+        uf.unite(i, i + 1);
+        uf.find(n - i - 1);
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(uf.nr_blocks() == 1);
+  for (size_t i = 0; i < n; i++) {
+    REQUIRE(uf.find(i) == 0);
+  }
+}
+
+TEST_CASE("UF 19: RollbackUF unite and rollback", "[quick][uf][19]") {
+  RollbackUF uf(8);
+  REQUIRE(uf.get_size() == 8);
+  REQUIRE(uf.nr_blocks() == 8);
+
+  REQUIRE(uf.unite(1, 2));
+  REQUIRE(uf.nr_blocks() == 7);
+  uf.checkpoint();
+  REQUIRE(uf.nr_checkpoints() == 1);
+  REQUIRE(uf.unite(5, 7));
+  REQUIRE(uf.unite(7, 2));
+  REQUIRE(!uf.unite(1, 5));
+  REQUIRE(uf.nr_blocks() == 5);
+  REQUIRE(uf.get_table() == UF::table_t({0, 1, 1, 3, 4, 1, 6, 1}));
+
+  uf.checkpoint();
+  REQUIRE(uf.unite(0, 6));
+  REQUIRE(uf.unite(6, 7));
+  REQUIRE(uf.nr_blocks() == 3);
+  REQUIRE(uf.get_table() == UF::table_t({0, 0, 0, 3, 4, 0, 0, 0}));
+
+  uf.rollback();
+  REQUIRE(uf.nr_checkpoints() == 1);
+  REQUIRE(uf.nr_blocks() == 5);
+  REQUIRE(uf.get_table() == UF::table_t({0, 1, 1, 3, 4, 1, 6, 1}));
+
+  uf.rollback();
+  REQUIRE(uf.nr_checkpoints() == 0);
+  REQUIRE(uf.nr_blocks() == 7);
+  REQUIRE(uf.get_table() == UF::table_t({0, 1, 1, 3, 4, 5, 6, 7}));
+  REQUIRE(uf.find(2) == uf.find(1));
+}
+
+TEST_CASE("UF 20: RollbackUF constructor by table", "[quick][uf][20]") {
+  RollbackUF uf(UF::table_t({0, 0, 2, 1, 2, 5, 6, 7, 8, 8, 4, 9}));
+  REQUIRE(uf.nr_blocks() == 6);
+  REQUIRE(uf.get_table()
+          == UF::table_t({0, 0, 2, 0, 2, 5, 6, 7, 8, 8, 2, 8}));
+  uf.checkpoint();
+  REQUIRE(uf.unite(11, 3));
+  REQUIRE(uf.unite(6, 7));
+  REQUIRE(uf.get_table()
+          == UF::table_t({0, 0, 2, 0, 2, 5, 6, 6, 0, 0, 2, 0}));
+  uf.rollback();
+  REQUIRE(uf.nr_blocks() == 6);
+  REQUIRE(uf.get_table()
+          == UF::table_t({0, 0, 2, 0, 2, 5, 6, 7, 8, 8, 2, 8}));
+}
+
+TEST_CASE("UF 21: RollbackUF big chain", "[quick][uf][21]") {
+  size_t     n = 10000;
+  RollbackUF uf(n);
+  uf.checkpoint();
+  for (size_t i = 0; i < n - 1; i++) {
+    uf.checkpoint();
+    REQUIRE(uf.unite(i, i + 1));
+    REQUIRE(uf.nr_blocks() == n - i - 1);
+  }
+  for (size_t i = 0; i < n - 1; i++) {
+    uf.rollback();
+    REQUIRE(uf.nr_blocks() == i + 2);
+  }
+  REQUIRE(uf.nr_checkpoints() == 1);
+  uf.rollback();
+  REQUIRE(uf.nr_blocks() == n);
+  for (size_t i = 0; i < n; i++) {
+    REQUIRE(uf.find(i) == i);
+  }
+}
+
+TEST_CASE("UF 22: big chain with path halving", "[quick][uf][22]") {
+  // Without path compression each find below takes O(n) steps.
+  size_t n = 100000;
+  UF     uf(n);
+  for (size_t i = n - 1; i > 0; i--) {
+    uf.unite(i - 1, i);
+  }
+  for (size_t k = 0; k < 10; k++) {
+    for (size_t i = n; i-- > 0;) {
+      REQUIRE(uf.find(i) == 0);
+    }
+  }
+  REQUIRE(uf.nr_blocks() == 1);
+  for (size_t i = 0; i < n; i++) {
+    REQUIRE((*uf.get_table())[i] == 0);
+  }
+}